@@ -14,15 +14,27 @@
 
 #include "moriarty/actions.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iterator>
 #include <memory>
+#include <regex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <variant>
 #include <vector>
 
 #include "moriarty/context.h"
 #include "moriarty/internal/analysis_bootstrap.h"
 #include "moriarty/internal/generation_bootstrap.h"
+#include "moriarty/internal/parallel.h"
 #include "moriarty/internal/random_engine.h"
 #include "moriarty/librarian/dependencies.h"
 #include "moriarty/librarian/errors.h"
@@ -39,6 +51,12 @@ ValidateInputBuilder& ValidateInputBuilder::ReadInputUsing(ReadOptions opts) {
   return *this;
 }
 
+ValidateInputBuilder& ValidateInputBuilder::ReadInputFiles(
+    ReadFilesOptions opts) {
+  input_files_options_ = std::move(opts);
+  return *this;
+}
+
 ValidateInputBuilder ValidateInput(Problem problem) {
   return ValidateInputBuilder(std::move(problem));
 }
@@ -74,29 +92,35 @@ struct GeneratedCase {
   TestCase test_case;
 };
 
+// Validates each test case, using up to `num_threads` threads. If several test
+// cases are invalid, the first one (in order) is reported.
 template <typename T>
 void ValidateTestCases(
-    const Problem& problem, const std::vector<T>& test_cases,
+    const Problem& problem, const std::vector<T>& test_cases, int num_threads,
     std::function<const TestCase&(const T&)> get_test_case =
         [](const T& item) -> const TestCase& { return item; }) {
   if (test_cases.empty()) {
     throw ValidationError("ValidateTestCases", "No Test Cases.");
   }
 
-  for (int case_num = 1; const auto& item : test_cases) {
-    std::vector<DetailedValidationResult> failures =
-        moriarty_internal::ValidateValues(
-            problem.UnsafeGetVariables(), get_test_case(item).UnsafeGetValues(),
-            {}, ValidationStyle::kOnlySetVariables);
-    if (!failures.empty()) {
-      if (test_cases.size() == 1) {
-        throw ValidationError(FailuresToString(failures));
-      }
-      throw ValidationError(std::format("Case #{} invalid:\n{}", case_num,
-                                        FailuresToString(failures)));
-    }
-    case_num++;
-  }
+  // With a single test case, spread its variables over the threads instead.
+  const int variable_threads = test_cases.size() == 1 ? num_threads : 1;
+  moriarty_internal::ParallelFor(
+      test_cases.size(), num_threads, [&](int64_t case_idx) {
+        std::vector<DetailedValidationResult> failures =
+            moriarty_internal::ValidateValues(
+                problem.UnsafeGetVariables(),
+                get_test_case(test_cases[case_idx]).UnsafeGetValues(), {},
+                ValidationStyle::kOnlySetVariables, variable_threads);
+        if (!failures.empty()) {
+          if (test_cases.size() == 1) {
+            throw ValidationError(FailuresToString(failures));
+          }
+          throw ValidationError(std::format("Case #{} invalid:\n{}",
+                                            case_idx + 1,
+                                            FailuresToString(failures)));
+        }
+      });
 }
 
 }  // namespace
@@ -129,7 +153,146 @@ void ValidateInputBuilder::Run() const {
   if (test_cases.empty())
     throw ConfigurationError("ValidateInput::Run", "No Test Cases.");
 
-  ValidateTestCases(problem_, test_cases);
+  ValidateTestCases(problem_, test_cases, input_options_->num_threads);
+}
+
+namespace {
+
+// Returns all existing files that match the filename pattern `pattern` (see
+// ReadFilesOptions), in sorted order.
+std::vector<std::filesystem::path> FilesMatchingPattern(std::string pattern) {
+  namespace fs = std::filesystem;
+  pattern += ".in";
+
+  static constexpr std::string_view kPlaceholders[] = {"{gen}", "{call}",
+                                                       "{idx}"};
+  size_t first_placeholder = std::string::npos;
+  for (std::string_view placeholder : kPlaceholders)
+    first_placeholder = std::min(first_placeholder, pattern.find(placeholder));
+  if (first_placeholder == std::string::npos) {
+    if (fs::is_regular_file(pattern)) return {pattern};
+    return {};
+  }
+
+  // Only the directory containing the first placeholder needs to be searched.
+  size_t slash = pattern.rfind('/', first_placeholder);
+  std::string prefix =
+      slash == std::string::npos ? "" : pattern.substr(0, slash + 1);
+  fs::path root = prefix.empty() ? fs::path(".") : fs::path(prefix);
+
+  std::string regex;
+  for (size_t i = prefix.size(); i < pattern.size();) {
+    if (pattern.compare(i, 5, "{gen}") == 0) {
+      regex += "[^/]+";
+      i += 5;
+    } else if (pattern.compare(i, 6, "{call}") == 0 ||
+               pattern.compare(i, 5, "{idx}") == 0) {
+      regex += "[0-9]+";
+      i += pattern[i + 1] == 'c' ? 6 : 5;
+    } else {
+      static constexpr std::string_view kSpecial = R"(\^$.|?*+()[]{})";
+      if (kSpecial.find(pattern[i]) != std::string_view::npos) regex += '\\';
+      regex += pattern[i++];
+    }
+  }
+  std::regex matcher(regex);
+
+  std::vector<fs::path> files;
+  std::error_code ec;
+  if (!fs::is_directory(root, ec)) return files;
+  fs::recursive_directory_iterator it(
+      root, fs::directory_options::skip_permission_denied, ec);
+  for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+    if (!it->is_regular_file(ec)) continue;
+    std::string relative =
+        it->path().lexically_relative(root).generic_string();
+    if (std::regex_match(relative, matcher)) files.push_back(prefix + relative);
+  }
+  if (ec) {
+    throw ConfigurationError(
+        "ValidateInput::RunOnFiles",
+        std::format("Failed to list the files in '{}': {}", root.string(),
+                    ec.message()));
+  }
+  std::ranges::sort(files);
+  return files;
+}
+
+// Reads and validates a single file. All errors are reported in the returned
+// results rather than thrown.
+ValidationResults ValidateInputFile(
+    const Problem& problem, const ReaderFn& reader,
+    const std::filesystem::path& file,
+    WhitespaceStrictness whitespace_strictness) {
+  ValidationResults results;
+  std::ifstream input(file);
+  if (!input.is_open()) {
+    results.AddFailure(
+        0, std::format("Failed to open file '{}' for reading.", file.string()));
+    return results;
+  }
+
+  try {
+    InputCursor cursor(input, whitespace_strictness);
+    ReadContext ctx(problem.UnsafeGetVariables(), cursor);
+    std::vector<TestCase> test_cases = ReadTestCases(reader, ctx);
+    if (test_cases.empty()) results.AddFailure(0, "No Test Cases.");
+
+    for (int i = 0; i < test_cases.size(); i++) {
+      std::vector<DetailedValidationResult> failures =
+          moriarty_internal::ValidateValues(
+              problem.UnsafeGetVariables(), test_cases[i].UnsafeGetValues(),
+              {}, ValidationStyle::kOnlySetVariables);
+      if (!failures.empty()) {
+        results.AddFailure(test_cases.size() == 1 ? 0 : i + 1,
+                           FailuresToString(failures));
+      }
+    }
+  } catch (const std::exception& e) {
+    // E.g., an IOError while reading. This only invalidates this file.
+    results.AddFailure(0, e.what());
+  }
+  return results;
+}
+
+}  // namespace
+
+std::vector<FileValidationResult> ValidateInputBuilder::RunOnFiles() const {
+  if (!input_files_options_) {
+    throw ConfigurationError("ValidateInput::RunOnFiles",
+                             "No files to read. Use ReadInputFiles() to "
+                             "specify options.");
+  }
+  auto reader = problem_.GetInputReader();
+  if (!reader) {
+    throw ConfigurationError(
+        "ValidateInput::RunOnFiles",
+        "No InputFormat specified in Problem. Cannot read input.");
+  }
+
+  const auto& files_or_pattern = input_files_options_->files;
+  std::vector<std::filesystem::path> files =
+      std::holds_alternative<ReadFilesOptions::FilenamePattern>(
+          files_or_pattern)
+          ? FilesMatchingPattern(
+                std::get<ReadFilesOptions::FilenamePattern>(files_or_pattern))
+          : std::get<std::vector<std::filesystem::path>>(files_or_pattern);
+  if (files.empty()) {
+    throw ConfigurationError("ValidateInput::RunOnFiles",
+                             "No input files to validate.");
+  }
+
+  std::vector<FileValidationResult> results(files.size());
+  moriarty_internal::ParallelFor(
+      files.size(), input_files_options_->num_threads, [&](int64_t i) {
+        results[i] = {
+            .file = files[i],
+            .results = ValidateInputFile(
+                problem_, *reader, files[i],
+                input_files_options_->whitespace_strictness),
+        };
+      });
+  return results;
 }
 
 ValidateOutputBuilder::ValidateOutputBuilder(Problem problem)
@@ -181,7 +344,7 @@ void ValidateOutputBuilder::Run() const {
   std::vector<TestCase> test_cases = ReadTestCases(*input_reader, ctx);
   if (test_cases.empty())
     throw ConfigurationError("ValidateOutput::Run", "No Test Cases.");
-  ValidateTestCases(problem_, test_cases);
+  ValidateTestCases(problem_, test_cases, input_options_->num_threads);
 
   if (test_cases.size() != 1) {
     throw ConfigurationError(
@@ -195,7 +358,7 @@ void ValidateOutputBuilder::Run() const {
                          test_cases[0].UnsafeGetValues(), output_cursor);
   std::vector<TestCase> output_answers =
       ReadTestCases(*output_reader, output_ctx);
-  ValidateTestCases(problem_, output_answers);
+  ValidateTestCases(problem_, output_answers, output_options_->num_threads);
 }
 
 GenerateBuilder Generate(Problem problem) {
@@ -210,6 +373,11 @@ GenerateBuilder& GenerateBuilder::WriteTo(WriteOptions opts) {
   return *this;
 }
 
+GenerateBuilder& GenerateBuilder::ValidateWithThreads(int num_threads) {
+  num_validation_threads_ = num_threads;
+  return *this;
+}
+
 namespace {
 
 std::vector<GeneratedCase> GenerateMTestCaseGenerator(
@@ -391,7 +559,7 @@ std::vector<TestCase> GenerateBuilder::Run() const {
   // TODO: Validate after the file split occurs once we allow multiple test
   // cases per file.
   ValidateTestCases<GeneratedCase>(
-      problem_, all_test_cases,
+      problem_, all_test_cases, num_validation_threads_,
       [](const GeneratedCase& item) -> const TestCase& {
         return item.test_case;
       });
@@ -443,6 +611,11 @@ AnalyzeBuilder& AnalyzeBuilder::ReadOutputUsing(ReadOptions opts) {
   return *this;
 }
 
+AnalyzeBuilder& AnalyzeBuilder::AnalyzeUsing(AnalyzeOptions opts) {
+  analyze_options_ = std::move(opts);
+  return *this;
+}
+
 AnalyzeBuilder Analyze(Problem problem) {
   return AnalyzeBuilder(std::move(problem));
 }
@@ -506,11 +679,47 @@ void AnalyzeBuilder::Run() const {
     }
   }
 
-  for (const auto& [name, analyzer] : analyzers_) {
-    moriarty_internal::ValueSet values;
-    AnalyzeContext ctx(problem_.UnsafeGetVariables(), values);
-    analyzer(ctx, test_cases);
+  // Each task runs one analyzer on some of the test cases and writes to its own
+  // buffer. The buffers are emitted in task order afterwards.
+  struct AnalyzeTask {
+    const NamedAnalyzer* analyzer;
+    std::span<const TestCase> test_cases;
+  };
+  std::vector<AnalyzeTask> tasks;
+  for (const NamedAnalyzer& analyzer : analyzers_) {
+    if (analyzer.single_test_case && analyze_options_.split_test_cases) {
+      for (const TestCase& tc : test_cases) {
+        tasks.push_back({&analyzer, {&tc, 1}});
+      }
+    } else {
+      tasks.push_back({&analyzer, test_cases});
+    }
+  }
+
+  std::vector<std::ostringstream> outputs(tasks.size());
+  std::vector<char> finished(tasks.size(), false);  // Not vector<bool>: racy.
+  auto emit_finished_prefix = [&] {
+    std::ostream& os = analyze_options_.ostream.get();
+    for (int i = 0; i < tasks.size() && finished[i]; i++) {
+      os << outputs[i].view();
+    }
+  };
+  try {
+    moriarty_internal::ParallelFor(
+        tasks.size(), analyze_options_.num_threads, [&](int64_t i) {
+          moriarty_internal::ValueSet values;
+          AnalyzeContext ctx(problem_.UnsafeGetVariables(), values,
+                             outputs[i]);
+          tasks[i].analyzer->analyzer(ctx, tasks[i].test_cases);
+          finished[i] = true;
+        });
+  } catch (...) {
+    // ParallelFor rethrows the failure of the earliest task, and every task
+    // before it has finished.
+    emit_finished_prefix();
+    throw;
   }
+  emit_finished_prefix();
 }
 
 }  // namespace moriarty
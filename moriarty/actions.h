@@ -15,7 +15,10 @@
 #ifndef MORIARTY_ACTIONS_H_
 #define MORIARTY_ACTIONS_H_
 
+#include <filesystem>
+#include <iostream>
 #include <optional>
+#include <string>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -26,6 +29,40 @@
 
 namespace moriarty {
 
+// ReadFilesOptions
+//
+// Options for reading many input files at once. See
+// ValidateInputBuilder::ReadInputFiles().
+struct ReadFilesOptions {
+  using FilenamePattern = std::string;
+
+  // Either an explicit list of files, or a filename pattern in the same format
+  // as GenerateBuilder::WriteTo() (e.g., "tests/{gen}/{call}_{idx}"). For a
+  // pattern, ".in" is appended and every existing file that matches is read:
+  // {gen} matches any non-empty text without a '/', while {call} and {idx}
+  // match non-negative integers.
+  std::variant<std::vector<std::filesystem::path>, FilenamePattern> files;
+
+  // How strict the reader should be about whitespace.
+  WhitespaceStrictness whitespace_strictness = WhitespaceStrictness::kPrecise;
+
+  // How many files to validate concurrently. If this is not positive, the
+  // number of hardware threads is used.
+  int num_threads = 0;
+};
+
+// FileValidationResult
+//
+// The result of validating a single file from ReadFilesOptions.
+struct FileValidationResult {
+  std::filesystem::path file;
+
+  // Failures are reported with the (1-indexed) test case number if the file
+  // contains multiple test cases. Errors that are not tied to a specific test
+  // case (e.g., the file could not be opened or parsed) use test case 0.
+  ValidationResults results;
+};
+
 // ValidateInputBuilder
 //
 // Validates the input for a problem. The InputFormat must be specified in
@@ -36,11 +73,21 @@ namespace moriarty {
 // ValidateInput(problem)
 //   .ReadInputUsing({.istream = std::cin})
 //   .Run();
+//
+// Or, to validate many files concurrently:
+//
+// ValidateInput(problem)
+//   .ReadInputFiles({.files = "tests/{gen}_{call}_{idx}"})
+//   .RunOnFiles();
 class ValidateInputBuilder {
  public:
   // Adds options for reading input.
   ValidateInputBuilder& ReadInputUsing(ReadOptions opts);
 
+  // [Experimental]
+  // Adds options for reading many input files. Used by RunOnFiles().
+  ValidateInputBuilder& ReadInputFiles(ReadFilesOptions opts);
+
   // Runs the validation. If there is an error, this throws an exception. In
   // general, exceptions from Moriarty derive from `GenericMoriartyError`. Other
   // exceptions are likely bugs.
@@ -49,6 +96,17 @@ class ValidateInputBuilder {
   // derive from GenericMoriartyError. This will be fixed in a future release.
   void Run() const;
 
+  // [Experimental]
+  // Validates each file from ReadInputFiles(), several at a time. The Problem
+  // is shared between all files, each of which is read and validated
+  // independently.
+  //
+  // Unlike Run(), invalid files do not throw. Instead, one result per file is
+  // returned, in the same order as the files were given (or in sorted order if
+  // a filename pattern was used). Misconfiguration (e.g., no InputFormat or no
+  // files matching the pattern) still throws a ConfigurationError.
+  [[nodiscard]] std::vector<FileValidationResult> RunOnFiles() const;
+
  private:
   // Construct a builder using `ValidateInput(problem)`.
   explicit ValidateInputBuilder(Problem problem);
@@ -56,6 +114,7 @@ class ValidateInputBuilder {
 
   Problem problem_;
   std::optional<ReadOptions> input_options_;
+  std::optional<ReadFilesOptions> input_files_options_;
 };
 
 // ValidateInput
@@ -209,6 +268,11 @@ class GenerateBuilder {
   // Otherwise, this is ignored.
   GenerateBuilder& WriteTo(WriteOptions opts);
 
+  // Specifies how many threads to validate the generated test cases with
+  // (optional, default 1). Independent test cases are validated concurrently.
+  // If this is not positive, the number of hardware threads is used.
+  GenerateBuilder& ValidateWithThreads(int num_threads);
+
   // Generates the test cases, writes them (if requested), and returns them.
   std::vector<TestCase> Run() const;
 
@@ -229,6 +293,7 @@ class GenerateBuilder {
   };
   std::vector<NamedGenerator> generators_;
   std::optional<WriteOptions> write_options_;
+  int num_validation_threads_ = 1;
 };
 
 // Generate
@@ -267,6 +332,23 @@ template <typename T>
 concept MoriartyAnalyzer =
     SingleTestCaseAnalyzer<T> || MultiTestCasesAnalyzer<T>;
 
+// AnalyzeOptions
+//
+// Options for running analyzers. See AnalyzeBuilder::AnalyzeUsing().
+struct AnalyzeOptions {
+  // Where to emit everything the analyzers write to AnalyzeContext::Output().
+  Ref<std::ostream> ostream = std::cout;
+
+  // How many analyzers to run concurrently. If this is not positive, the
+  // number of hardware threads is used. Analyzers that share state (e.g., by
+  // capturing a variable by reference) must synchronize it themselves.
+  int num_threads = 1;
+
+  // If true, a single test case analyzer may also be called for several test
+  // cases at once. Its output is still emitted in test case order.
+  bool split_test_cases = false;
+};
+
 // AnalyzeBuilder
 //
 // Analyzes test cases for a problem. Analyzers are most typically used to
@@ -303,7 +385,14 @@ class AnalyzeBuilder {
   // input variables. This will be fixed in a future release.
   AnalyzeBuilder& ReadOutputUsing(ReadOptions opts);
 
-  // Runs each test case through each analyzer.
+  // Specifies how to run the analyzers (optional). By default, the analyzers
+  // run one at a time and their output goes to std::cout.
+  AnalyzeBuilder& AnalyzeUsing(AnalyzeOptions opts);
+
+  // Runs each test case through each analyzer. The output of each analyzer is
+  // emitted in the order the analyzers were added, even if they ran
+  // concurrently. If an analyzer throws, the output of all analyzers before it
+  // is emitted and the exception is rethrown.
   void Run() const;
 
  private:
@@ -316,10 +405,13 @@ class AnalyzeBuilder {
   struct NamedAnalyzer {
     std::string name;
     std::function<void(AnalyzeContext, std::span<const TestCase>)> analyzer;
+    // Whether `analyzer` handles each test case independently.
+    bool single_test_case = false;
   };
   std::vector<NamedAnalyzer> analyzers_;
   std::optional<ReadOptions> input_reader_;
   std::optional<ReadOptions> output_reader_;
+  AnalyzeOptions analyze_options_;
 };
 
 // Analyze
@@ -388,6 +480,7 @@ AnalyzeBuilder& AnalyzeBuilder::Using(std::string name, Analyzer analyzer) {
                             std::span<const TestCase> cases) {
       for (const TestCase& tc : cases) analyzer(ctx, tc);
     };
+    a.single_test_case = true;
   } else if constexpr (MultiTestCasesAnalyzer<Analyzer>) {
     a.analyzer = [analyzer](AnalyzeContext ctx,
                             std::span<const TestCase> cases) {
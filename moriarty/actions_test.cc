@@ -16,8 +16,14 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -36,7 +42,9 @@ namespace moriarty {
 namespace {
 
 using ::moriarty_testing::SingleCall;
+using ::testing::Each;
 using ::testing::ElementsAre;
+using ::testing::Field;
 using ::testing::HasSubstr;
 using ::testing::SizeIs;
 using ::testing::ThrowsMessage;
@@ -122,6 +130,22 @@ TEST(ValidateInputTest, ValidMultipleTestCasesShouldSucceed) {
   EXPECT_NO_THROW(ValidateInput(p).ReadInputUsing({.istream = input}).Run());
 }
 
+TEST(ValidateInputTest, ValidMultipleTestCasesWithManyThreadsShouldSucceed) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10))),
+                      Var("X", MInteger(Between(20, 25)))),
+            InputFormat(
+                SimpleIO().WithNumberOfTestCasesInHeader().AddLine("N", "X")));
+
+  std::string input_str = "1000\n";
+  for (int i = 0; i < 1000; i++) {
+    input_str += std::format("{} 2{}\n", i % 10 + 1, i % 6);
+  }
+  std::istringstream input(input_str);
+  EXPECT_NO_THROW(ValidateInput(p)
+                      .ReadInputUsing({.istream = input, .num_threads = 4})
+                      .Run());
+}
+
 TEST(ValidateInputTest, InvalidMultipleTestCasesShouldFail) {
   Problem p(Variables(Var("N", MInteger(Between(1, 10))),
                       Var("X", MInteger(Between(20, 25)))),
@@ -163,6 +187,129 @@ TEST(ValidateInputTest, WhitespaceStrictnessShouldBeRespected) {
                       .Run());
 }
 
+std::filesystem::path EmptyTestDirectory(std::string_view name) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  if (test_tmpdir == nullptr) ADD_FAILURE() << "TEST_TMPDIR is not set";
+  std::filesystem::path directory = std::filesystem::path(test_tmpdir) / name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+void WriteFile(const std::filesystem::path& path, std::string_view contents) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream(path) << contents;
+}
+
+MATCHER_P(FileResultIs, valid, "") {
+  if (arg.results.IsValid() == valid) return true;
+  *result_listener << arg.file << ": " << arg.results.DescribeFailures();
+  return false;
+}
+
+TEST(ValidateInputTest, RunOnFilesShouldReportEachFile) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10)))),
+            InputFormat(Line("N")));
+  std::filesystem::path dir = EmptyTestDirectory("RunOnFilesShouldReport");
+  WriteFile(dir / "valid.in", "5\n");
+  WriteFile(dir / "invalid.in", "11\n");
+  WriteFile(dir / "unreadable.in", "five\n");
+
+  std::vector<FileValidationResult> results =
+      ValidateInput(p)
+          .ReadInputFiles({.files = std::vector<std::filesystem::path>(
+                               {dir / "valid.in", dir / "invalid.in",
+                                dir / "unreadable.in", dir / "missing.in"})})
+          .RunOnFiles();
+
+  ASSERT_THAT(results, SizeIs(4));
+  EXPECT_EQ(results[0].file, dir / "valid.in");
+  EXPECT_THAT(results[0], FileResultIs(true));
+  EXPECT_EQ(results[1].file, dir / "invalid.in");
+  EXPECT_THAT(results[1].results.DescribeFailures(), HasSubstr("N"));
+  EXPECT_THAT(results[2], FileResultIs(false));
+  EXPECT_THAT(results[3].results.DescribeFailures(),
+              HasSubstr("Failed to open"));
+}
+
+TEST(ValidateInputTest, RunOnFilesShouldHandleMultipleTestCases) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10)))),
+            InputFormat(
+                SimpleIO().WithNumberOfTestCasesInHeader().AddLine("N")));
+  std::filesystem::path dir = EmptyTestDirectory("MultipleTestCases");
+  WriteFile(dir / "valid.in", "3\n1\n5\n10\n");
+  WriteFile(dir / "invalid.in", "3\n1\n11\n10\n");
+
+  std::vector<FileValidationResult> results =
+      ValidateInput(p)
+          .ReadInputFiles({.files = std::vector<std::filesystem::path>(
+                               {dir / "valid.in", dir / "invalid.in"})})
+          .RunOnFiles();
+  ASSERT_THAT(results, SizeIs(2));
+  EXPECT_THAT(results[0], FileResultIs(true));
+  EXPECT_THAT(results[1].results.DescribeFailures(), HasSubstr("N: 11"));
+}
+
+TEST(ValidateInputTest, RunOnFilesShouldFindFilesWrittenByGenerate) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10)))), Seed("test_seed"),
+            InputFormat(Line("N")));
+  std::filesystem::path dir = EmptyTestDirectory("FindFilesWrittenByGenerate");
+  std::string pattern = (dir / "{gen}" / "{call}_{idx}").string();
+
+  (void)Generate(p)
+      .Using("Gen", [](GenerateContext ctx) { return MTestCase(); },
+             {.num_calls = 3})
+      .WriteTo(pattern)
+      .Run();
+  WriteFile(dir / "Gen" / "notes.txt", "not a test");
+  WriteFile(dir / "Gen" / "x_1.in", "100\n");  // {call} must be a number.
+
+  EXPECT_THAT(ValidateInput(p).ReadInputFiles({.files = pattern}).RunOnFiles(),
+              ElementsAre(Field(&FileValidationResult::file,
+                                dir / "Gen" / "0_1.in"),
+                          Field(&FileValidationResult::file,
+                                dir / "Gen" / "1_1.in"),
+                          Field(&FileValidationResult::file,
+                                dir / "Gen" / "2_1.in")));
+  EXPECT_THAT(ValidateInput(p).ReadInputFiles({.files = pattern}).RunOnFiles(),
+              Each(FileResultIs(true)));
+}
+
+TEST(ValidateInputTest, RunOnFilesShouldValidateManyFilesConcurrently) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10))),
+                      Var("A", MArray<MInteger>(Elements(Between(1, 5)),
+                                                Length("N")))),
+            InputFormat(Line("N"), Line("A")));
+  std::filesystem::path dir = EmptyTestDirectory("ManyFilesConcurrently");
+  std::vector<std::filesystem::path> files;
+  for (int i = 0; i < 200; i++) {
+    files.push_back(dir / std::format("{}.in", i));
+    WriteFile(files.back(), i % 3 == 0 ? "3\n1 2 6\n" : "3\n1 2 5\n");
+  }
+
+  std::vector<FileValidationResult> results =
+      ValidateInput(p)
+          .ReadInputFiles({.files = files, .num_threads = 4})
+          .RunOnFiles();
+  ASSERT_THAT(results, SizeIs(200));
+  for (int i = 0; i < 200; i++) {
+    EXPECT_EQ(results[i].file, files[i]);
+    EXPECT_THAT(results[i], FileResultIs(i % 3 != 0));
+  }
+}
+
+TEST(ValidateInputTest, RunOnFilesWithoutFilesShouldThrow) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10)))),
+            InputFormat(Line("N")));
+  EXPECT_THROW((void)ValidateInput(p).RunOnFiles(), ConfigurationError);
+
+  std::filesystem::path dir = EmptyTestDirectory("WithoutFiles");
+  EXPECT_THROW((void)ValidateInput(p)
+                   .ReadInputFiles({.files = (dir / "{idx}").string()})
+                   .RunOnFiles(),
+               ConfigurationError);
+}
+
 // -----------------------------------------------------------------------------
 
 TEST(ValidateOutputTest, WorksForValidOutput) {
@@ -402,6 +549,30 @@ TEST(GenerateTest, ConstraintsShouldBeRespected) {
   EXPECT_THAT(observed_values, ElementsAre(8, 9, 10));
 }
 
+TEST(GenerateTest, ValidationWithManyThreadsShouldReportTheFirstInvalidCase) {
+  Problem p(Variables(Var("N", MInteger(Between(1, 10)))), Seed("test_seed"));
+
+  for (int num_threads : {1, 4}) {
+    int generator_calls = 0;
+    EXPECT_THAT(SingleCall([&] {
+                  Generate(p)
+                      .Using("TestGenerator",
+                             [&generator_calls](GenerateContext ctx) {
+                               generator_calls++;
+                               bool bad = generator_calls == 37 ||
+                                          generator_calls == 80;
+                               return TestCase().SetValue<MInteger>(
+                                   "N", bad ? 11 : 5);
+                             },
+                             {.num_calls = 100})
+                      .ValidateWithThreads(num_threads)
+                      .Run();
+                }),
+                ThrowsMessage<ValidationError>(HasSubstr("Case #37 invalid")))
+        << "num_threads = " << num_threads;
+  }
+}
+
 TEST(GenerateTest, GenerateShouldOnlyAutoGenerateTheInputVariables) {
   Problem p(Variables(Var("N", MInteger(Between(1, 10))),
                       Var("M", MInteger(Between(1, 10)))),
@@ -852,6 +1023,63 @@ TEST(AnalyzeTest, MultipleAnalyzersShouldAllRun) {
   EXPECT_EQ(analyzer2_calls, 1);
 }
 
+TEST(AnalyzeTest, AnalyzerOutputShouldBeEmittedInOrder) {
+  Problem p(
+      Variables(Var("N", MInteger(Between(1, 10)))),
+      InputFormat(SimpleIO().WithNumberOfTestCasesInHeader().AddLine("N")));
+
+  for (int num_threads : {1, 4}) {
+    for (bool split_test_cases : {false, true}) {
+      std::istringstream input("3\n5\n7\n9\n");
+      std::ostringstream output;
+      Analyze(p)
+          .Using("Single",
+                 [](AnalyzeContext ctx, const TestCase& tc) {
+                   ctx.Output() << "N=" << tc.GetValue<MInteger>("N") << "\n";
+                 })
+          .Using("Multi",
+                 [](AnalyzeContext ctx, std::span<const TestCase> cases) {
+                   ctx.Output() << "Count=" << cases.size() << "\n";
+                 })
+          .ReadInputUsing({.istream = input})
+          .AnalyzeUsing({.ostream = output,
+                         .num_threads = num_threads,
+                         .split_test_cases = split_test_cases})
+          .Run();
+
+      EXPECT_EQ(output.str(), "N=5\nN=7\nN=9\nCount=3\n")
+          << "num_threads = " << num_threads
+          << ", split_test_cases = " << split_test_cases;
+    }
+  }
+}
+
+TEST(AnalyzeTest, FailingAnalyzerShouldEmitEarlierOutputAndThrow) {
+  Problem p(
+      Variables(Var("N", MInteger(Between(1, 10)))),
+      InputFormat(SimpleIO().WithNumberOfTestCasesInHeader().AddLine("N")));
+
+  std::istringstream input("3\n5\n7\n9\n");
+  std::ostringstream output;
+  EXPECT_THAT(
+      SingleCall([&] {
+        Analyze(p)
+            .Using("Single",
+                   [](AnalyzeContext ctx, const TestCase& tc) {
+                     int n = tc.GetValue<MInteger>("N");
+                     if (n == 7) throw std::runtime_error("Bad seven");
+                     ctx.Output() << "N=" << n << "\n";
+                   })
+            .ReadInputUsing({.istream = input})
+            .AnalyzeUsing({.ostream = output,
+                           .num_threads = 4,
+                           .split_test_cases = true})
+            .Run();
+      }),
+      ThrowsMessage<std::runtime_error>(HasSubstr("Bad seven")));
+  EXPECT_EQ(output.str(), "N=5\n");
+}
+
 TEST(AnalyzeTest, ReadingOutputShouldWork) {
   Problem p(Variables(Var("N", MInteger(Between(1, 10))),
                       Var("Result", MInteger(Between(1, 100)))),
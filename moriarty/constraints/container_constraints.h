@@ -15,9 +15,14 @@
 #ifndef MORIARTY_CONSTRAINTS_CONTAINER_CONSTRAINTS_H_
 #define MORIARTY_CONSTRAINTS_CONTAINER_CONSTRAINTS_H_
 
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <functional>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -27,7 +32,9 @@
 #include "absl/container/flat_hash_map.h"
 #include "moriarty/constraints/base_constraints.h"
 #include "moriarty/constraints/constraint_violation.h"
+#include "moriarty/types/matrix.h"
 #include "moriarty/variables/minteger.h"
+#include "moriarty/variables/mreal.h"
 
 namespace moriarty {
 
@@ -118,6 +125,12 @@ class StronglyTypedElements : public MConstraint {
       ConstraintContext ctx,
       const std::vector<typename MElementType::value_type>& value) const;
 
+  // Determines if the matrix's entries satisfy all constraints. (A template so
+  // that braced lists still pick the `std::vector` overload above.)
+  template <std::same_as<Matrix<typename MElementType::value_type>> MatrixType>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const MatrixType& value) const;
+
   // Returns a string representation of this constraint.
   [[nodiscard]] std::string ToString() const;
 
@@ -126,6 +139,12 @@ class StronglyTypedElements : public MConstraint {
 
  private:
   MElementType element_constraints_;
+
+  // Returns the index of an element that does not satisfy all constraints, or
+  // std::nullopt if they all do.
+  std::optional<size_t> FindInvalidElement(
+      ConstraintContext ctx,
+      std::span<const typename MElementType::value_type> values) const;
 };
 
 // Constraints that the I-th element of a container (probably a tuple) must
@@ -194,6 +213,10 @@ class Sorted : public BasicMConstraint {
                                    const typename MElementType::value_type&)>
   GetComparator() const;
 
+  // Sorts `values` using `comp` and `proj`. Unlike sorting with
+  // `GetComparator()`, the comparator is not type-erased, so it can be inlined.
+  void Sort(std::vector<typename MElementType::value_type>& values) const;
+
  private:
   Comp comp_;
   Proj proj_;
@@ -262,16 +285,45 @@ template <typename MElementType>
 ValidationResult StronglyTypedElements<MElementType>::Validate(
     ConstraintContext ctx,
     const std::vector<typename MElementType::value_type>& value) const {
+  std::optional<size_t> invalid = FindInvalidElement(ctx, value);
+  if (!invalid) return ValidationResult::Ok();
+
   auto index_name = [](int idx) { return std::format("index {}", idx); };
-  for (int idx = -1; const auto& elem : value) {
-    idx++;
-    if (auto v = element_constraints_.Validate(
-            ctx.ForIndexedSubVariable(index_name, idx), elem);
-        !v.IsOk()) {
-      return ctx.Violation(value, std::move(v));
+  auto v = element_constraints_.Validate(
+      ctx.ForIndexedSubVariable(index_name, *invalid), value[*invalid]);
+  return ctx.Violation(value, std::move(v));
+}
+
+template <typename MElementType>
+template <std::same_as<Matrix<typename MElementType::value_type>> MatrixType>
+ValidationResult StronglyTypedElements<MElementType>::Validate(
+    ConstraintContext ctx, const MatrixType& value) const {
+  std::optional<size_t> invalid = FindInvalidElement(ctx, value.Entries());
+  if (!invalid) return ValidationResult::Ok();
+
+  int64_t row = *invalid / value.NumCols();
+  int64_t col = *invalid % value.NumCols();
+  auto entry_name = [col](int row) {
+    return std::format("entry ({}, {})", row, col);
+  };
+  auto v = element_constraints_.Validate(
+      ctx.ForIndexedSubVariable(entry_name, row), value(row, col));
+  return ctx.Violation(value, std::move(v));
+}
+
+template <typename MElementType>
+std::optional<size_t> StronglyTypedElements<MElementType>::FindInvalidElement(
+    ConstraintContext ctx,
+    std::span<const typename MElementType::value_type> values) const {
+  if constexpr (std::same_as<MElementType, MInteger> ||
+                std::same_as<MElementType, MReal>) {
+    return element_constraints_.FindInvalidValue(ctx, values);
+  } else {
+    for (size_t i = 0; i < values.size(); i++) {
+      if (!element_constraints_.Validate(ctx, values[i]).IsOk()) return i;
     }
+    return std::nullopt;
   }
-  return ValidationResult::Ok();
 }
 
 template <typename MElementType>
@@ -317,6 +369,15 @@ Dependencies Element<I, MElementType>::GetDependencies() const {
 template <typename T>
 ValidationResult DistinctElements::Validate(ConstraintContext ctx,
                                             const std::vector<T>& value) const {
+  if constexpr (std::integral<T>) {
+    // Sorting a copy is much cheaper than hashing every element. The hash map
+    // below is only needed to report which indices are duplicated.
+    std::vector<T> sorted = value;
+    std::ranges::sort(sorted);
+    if (std::ranges::adjacent_find(sorted) == sorted.end())
+      return ValidationResult::Ok();
+  }
+
   absl::flat_hash_map<T, int> seen;
   for (int idx = -1; const auto& elem : value) {
     idx++;
@@ -343,26 +404,32 @@ template <typename MElementType, typename Comp, typename Proj>
 std::function<bool(const typename MElementType::value_type&,
                    const typename MElementType::value_type&)>
 Sorted<MElementType, Comp, Proj>::GetComparator() const {
-  return [this](const typename MElementType::value_type& lhs,
-                const typename MElementType::value_type& rhs) {
-    return Compare(lhs, rhs);
+  // Capture by value: the returned function may outlive this constraint.
+  return [comp = comp_, proj = proj_](
+             const typename MElementType::value_type& lhs,
+             const typename MElementType::value_type& rhs) {
+    return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
   };
 }
 
+template <typename MElementType, typename Comp, typename Proj>
+void Sorted<MElementType, Comp, Proj>::Sort(
+    std::vector<typename MElementType::value_type>& values) const {
+  std::ranges::sort(values, comp_, proj_);
+}
+
 template <typename MElementType, typename Comp, typename Proj>
 ValidationResult Sorted<MElementType, Comp, Proj>::Validate(
     ConstraintContext ctx,
     const std::vector<typename MElementType::value_type>& value) const {
-  for (size_t i = 1; i < value.size(); ++i) {
-    if (Compare(value[i], value[i - 1])) {
-      return ctx.Violation(value,
-                           ValidationResult::Violation(
-                               std::format("indices {} and {}", i - 1, i),
-                               std::make_tuple(value[i - 1], value[i]),
-                               librarian::Expected("sorted")));
-    }
-  }
-  return ValidationResult::Ok();
+  auto it = std::ranges::is_sorted_until(value, comp_, proj_);
+  if (it == value.end()) return ValidationResult::Ok();
+
+  size_t i = it - value.begin();
+  return ctx.Violation(value, ValidationResult::Violation(
+                                  std::format("indices {} and {}", i - 1, i),
+                                  std::make_tuple(value[i - 1], value[i]),
+                                  librarian::Expected("sorted")));
 }
 
 }  // namespace moriarty
@@ -15,16 +15,20 @@
 
 #include "moriarty/constraints/container_constraints.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "moriarty/constraints/integer_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
 #include "moriarty/contexts/librarian_context.h"
 #include "moriarty/internal/value_set.h"
 #include "moriarty/internal/variable_set.h"
 #include "moriarty/librarian/testing/gtest_helpers.h"
 #include "moriarty/variables/minteger.h"
+#include "moriarty/variables/mreal.h"
 #include "moriarty/variables/mstring.h"
 
 namespace moriarty {
@@ -162,6 +166,27 @@ TEST(ContainerConstraintsTest, ElementsIsSatisfiedWithWorks) {
   }
 }
 
+TEST(ContainerConstraintsTest, ElementsReportsTheFirstInvalidIndex) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("N", variables, values);
+
+  EXPECT_THAT(StronglyTypedElements<MInteger>(Between(1, 10))
+                  .Validate(ctx, std::vector<int64_t>{5, 11, 0, 12}),
+              HasViolation(
+                  AllOf(HasSubstr("index 1"), HasSubstr("too large"))));
+  EXPECT_THAT(StronglyTypedElements<MInteger>(Between(1, 10), Mod(1, 2))
+                  .Validate(ctx, std::vector<int64_t>{1, 3, 4, 5}),
+              HasViolation(HasSubstr("index 2")));
+  EXPECT_THAT(StronglyTypedElements<MReal>(Between(0, 1))
+                  .Validate(ctx, std::vector<double>{0.5, 0.25, 1.5, -1}),
+              HasViolation(
+                  AllOf(HasSubstr("index 2"), HasSubstr("too large"))));
+  EXPECT_THAT(StronglyTypedElements<MReal>(Between(0, 1))
+                  .Validate(ctx, std::vector<double>{0.5, 0.25, 1.0, 0.0}),
+              HasNoViolation());
+}
+
 TEST(ContainerConstraintsTest, ElementConstraintsAreCorrect) {
   EXPECT_THAT((Element<0, MInteger>(Between(1, 10)).GetConstraints()),
               GeneratedValuesAre(AllOf(Ge(1), Le(10))));
@@ -234,6 +259,15 @@ TEST(ContainerConstraintsTest, DistinctElementsUnsatisfiedReasonWorks) {
   EXPECT_THAT(DistinctElements().Validate(ctx, std::vector{1, 2, 3, 2, 2, 3}),
               HasViolation(AllOf(HasSubstr("indices 1 and 3"),
                                  HasSubstr("distinct elements"))));
+  EXPECT_THAT(
+      DistinctElements().Validate(ctx, std::vector<int64_t>{5, 9, -7, 9, 5}),
+      HasViolation(AllOf(HasSubstr("indices 1 and 3"),
+                         HasSubstr("distinct elements"))));
+  EXPECT_THAT(DistinctElements().Validate(ctx, std::vector<int64_t>{8, 2, 8}),
+              HasViolation(AllOf(HasSubstr("indices 0 and 2"),
+                                 HasSubstr("distinct elements"))));
+  EXPECT_THAT(DistinctElements().Validate(ctx, std::vector<int64_t>{3, 1, 2}),
+              HasNoViolation());
 }
 
 TEST(ContainerConstraintsTest, DistinctElementsIsSatisfiedWithWorks) {
@@ -285,6 +319,9 @@ TEST(ContainerConstraintsTest, SortedWorks) {
                 HasViolation(HasSubstr("sorted")));
     EXPECT_THAT((Sorted<MInteger>().Validate(ctx, {2, 2, 2, 2, 1})),
                 HasViolation(HasSubstr("sorted")));
+    EXPECT_THAT((Sorted<MInteger>().Validate(ctx, {1, 3, 2, 1})),
+                HasViolation(AllOf(HasSubstr("indices 1 and 2"),
+                                   HasSubstr("sorted"))));
   }
 }
 
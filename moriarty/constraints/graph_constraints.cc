@@ -14,12 +14,16 @@
 
 #include "moriarty/constraints/graph_constraints.h"
 
+#include <cstdint>
 #include <format>
+#include <numeric>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/librarian/errors.h"
 #include "moriarty/librarian/dependencies.h"
 #include "moriarty/variables/minteger.h"
 
@@ -59,4 +63,80 @@ Dependencies NumEdges::GetDependencies() const {
   return num_edges_.GetDependencies();
 }
 
+// ====== Tree ======
+Tree Tree::Path() { return Tree(Shape::kPath, "is a path"); }
+
+Tree Tree::Star() { return Tree(Shape::kStar, "is a star"); }
+
+Tree Tree::Caterpillar() {
+  return Tree(Shape::kCaterpillar, "is a caterpillar tree");
+}
+
+// ====== Forest ======
+Forest::Forest(int64_t num_trees)
+    : num_trees_(Exactly(num_trees)), num_trees_constrained_(true) {}
+
+Forest::Forest(std::string_view expression)
+    : num_trees_(Exactly(expression)), num_trees_constrained_(true) {}
+
+MInteger Forest::GetNumTrees() const { return num_trees_; }
+
+std::string Forest::ToString() const {
+  if (!num_trees_constrained_) return "is a forest";
+  return std::format("is a forest whose number of trees {}",
+                     num_trees_.ToString());
+}
+
+Dependencies Forest::GetDependencies() const {
+  return num_trees_.GetDependencies();
+}
+
+// ====== Bipartite ======
+Bipartite::Bipartite(int64_t num_left, int64_t num_right)
+    : BasicMConstraint(std::format(
+          "is a bipartite graph with sides of size {} and {}", num_left,
+          num_right)),
+      sides_(std::make_pair(num_left, num_right)) {
+  if (num_left < 0 || num_right < 0) {
+    throw InvalidConstraint("Bipartite", "Sides must have non-negative size");
+  }
+}
+
+// ====== Grid ======
+Grid::Grid(int64_t num_rows, int64_t num_cols)
+    : BasicMConstraint(
+          std::format("is a {}x{} grid graph", num_rows, num_cols)),
+      num_rows_(num_rows),
+      num_cols_(num_cols) {
+  if (num_rows < 0 || num_cols < 0) {
+    throw InvalidConstraint("Grid", "Dimensions must be non-negative");
+  }
+}
+
+namespace moriarty_internal {
+
+DisjointSets::DisjointSets(int64_t size) : parent_(size), size_(size, 1) {
+  std::iota(parent_.begin(), parent_.end(), 0);
+}
+
+int64_t DisjointSets::Find(int64_t x) {
+  while (parent_[x] != x) {
+    parent_[x] = parent_[parent_[x]];  // Path halving
+    x = parent_[x];
+  }
+  return x;
+}
+
+bool DisjointSets::Unite(int64_t x, int64_t y) {
+  x = Find(x);
+  y = Find(y);
+  if (x == y) return false;
+  if (size_[x] < size_[y]) std::swap(x, y);
+  parent_[y] = x;
+  size_[x] += size_[y];
+  return true;
+}
+
+}  // namespace moriarty_internal
+
 }  // namespace moriarty
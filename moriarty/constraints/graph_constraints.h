@@ -15,8 +15,14 @@
 #ifndef MORIARTY_CONSTRAINTS_GRAPH_CONSTRAINTS_H_
 #define MORIARTY_CONSTRAINTS_GRAPH_CONSTRAINTS_H_
 
-#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "moriarty/constraints/base_constraints.h"
 #include "moriarty/constraints/constraint_violation.h"
@@ -149,6 +155,152 @@ class SimpleGraph : public BasicMConstraint {
                             const Graph<EdgeLabel, NodeLabel>& value) const;
 };
 
+// The graph must be a tree: connected and without cycles (so it has exactly
+// one fewer edge than it has nodes). Like Connected(), the graph with 0 nodes
+// is *not* a tree.
+//
+// By default, any tree is allowed. The static factories below also restrict
+// the shape of the tree.
+class Tree : public BasicMConstraint {
+ public:
+  enum class Shape { kAny, kPath, kStar, kCaterpillar };
+
+  // Any tree.
+  explicit Tree() : Tree(Shape::kAny, "is a tree") {}
+
+  // A tree in which every node has degree at most 2.
+  static Tree Path();
+  // A tree with a node that is adjacent to every other node.
+  static Tree Star();
+  // A tree that becomes a path once all of its leaves are removed.
+  static Tree Caterpillar();
+
+  // Returns the required shape of the tree.
+  [[nodiscard]] Shape GetShape() const { return shape_; }
+
+  // Determines if the graph is a tree of the required shape.
+  template <typename EdgeLabel, typename NodeLabel>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Graph<EdgeLabel, NodeLabel>& value) const;
+
+ private:
+  Tree(Shape shape, std::string_view description)
+      : BasicMConstraint(description), shape_(shape) {}
+
+  Shape shape_;
+};
+
+// The graph must be a forest: it contains no cycles (in particular, no loops
+// and no parallel edges). Each connected component is a tree, so a forest
+// with n nodes and k trees has exactly n - k edges.
+class Forest : public MConstraint {
+ public:
+  // The forest may have any number of trees.
+  explicit Forest() = default;
+
+  // The forest must have exactly this many trees.
+  explicit Forest(int64_t num_trees);
+
+  // The number of trees must be exactly this integer expression.
+  // E.g., Forest("K").
+  explicit Forest(std::string_view expression);
+
+  // The number of trees must satisfy all of these constraints.
+  // E.g., Forest(Between(1, "K"))
+  template <typename... Constraints>
+    requires(std::constructible_from<MInteger, Constraints...> &&
+             sizeof...(Constraints) > 0)
+  explicit Forest(Constraints&&... constraints);
+
+  // Returns the constraints on the number of trees.
+  [[nodiscard]] MInteger GetNumTrees() const;
+
+  // Determines if the graph is a forest with the correct number of trees.
+  template <typename EdgeLabel, typename NodeLabel>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Graph<EdgeLabel, NodeLabel>& value) const;
+
+  // Returns a string representation of this constraint.
+  [[nodiscard]] std::string ToString() const;
+
+  // Returns all variables that this constraint depends on.
+  Dependencies GetDependencies() const;
+
+ private:
+  MInteger num_trees_;
+  bool num_trees_constrained_ = false;
+};
+
+// The graph must be bipartite: its nodes can be split into two sides so that
+// every edge joins two nodes on opposite sides.
+class Bipartite : public BasicMConstraint {
+ public:
+  // The nodes may be split in any way.
+  explicit Bipartite() : BasicMConstraint("is a bipartite graph") {}
+
+  // Nodes 0, 1, ..., num_left - 1 are on one side and the num_right nodes after
+  // them are on the other. In particular, the graph has exactly
+  // num_left + num_right nodes.
+  explicit Bipartite(int64_t num_left, int64_t num_right);
+
+  // Returns the sizes of the two sides, if they were specified.
+  [[nodiscard]] std::optional<std::pair<int64_t, int64_t>> GetSides() const {
+    return sides_;
+  }
+
+  // Determines if the graph is bipartite (with the required sides).
+  template <typename EdgeLabel, typename NodeLabel>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Graph<EdgeLabel, NodeLabel>& value) const;
+
+ private:
+  std::optional<std::pair<int64_t, int64_t>> sides_;
+};
+
+// The graph must be the `num_rows` x `num_cols` grid graph. Node
+// r * num_cols + c is the cell in row r and column c (both 0-based), and
+// there is exactly one edge between each pair of horizontally or vertically
+// adjacent cells.
+class Grid : public BasicMConstraint {
+ public:
+  explicit Grid(int64_t num_rows, int64_t num_cols);
+
+  // Returns the number of rows in the grid.
+  [[nodiscard]] int64_t NumRows() const { return num_rows_; }
+  // Returns the number of columns in the grid.
+  [[nodiscard]] int64_t NumCols() const { return num_cols_; }
+
+  // Determines if the graph is this grid graph.
+  template <typename EdgeLabel, typename NodeLabel>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Graph<EdgeLabel, NodeLabel>& value) const;
+
+ private:
+  int64_t num_rows_;
+  int64_t num_cols_;
+};
+
+namespace moriarty_internal {
+
+// Disjoint sets over {0, 1, ..., size - 1}.
+class DisjointSets {
+ public:
+  explicit DisjointSets(int64_t size);
+
+  // Returns the representative of the set containing `x`.
+  int64_t Find(int64_t x);
+
+  // Merges the sets containing `x` and `y`. Returns false if they were already
+  // in the same set.
+  bool Unite(int64_t x, int64_t y);
+
+ private:
+  std::vector<int64_t> parent_;
+  std::vector<int64_t> size_;
+};
+
+}  // namespace moriarty_internal
+
 // Constraints that all node labels of a graph must satisfy.
 template <typename MLabelType>
 class NodeLabels : public MConstraint {
@@ -224,6 +376,13 @@ template <typename... Constraints>
 NumNodes::NumNodes(Constraints&&... constraints)
     : num_nodes_(std::forward<Constraints>(constraints)...) {}
 
+template <typename... Constraints>
+  requires(std::constructible_from<MInteger, Constraints...> &&
+           sizeof...(Constraints) > 0)
+Forest::Forest(Constraints&&... constraints)
+    : num_trees_(std::forward<Constraints>(constraints)...),
+      num_trees_constrained_(true) {}
+
 // ====== NodeLabels ======
 template <typename MLabelType>
 template <typename... Constraints>
@@ -285,7 +444,7 @@ ValidationResult EdgeLabels<MLabelType>::Validate(
     const Graph<typename MLabelType::value_type, NodeLabel>& value) const {
   auto edge_name = [](int idx) { return std::format("edge {}'s label", idx); };
   int idx = -1;
-  for (const auto& edge : value.GetEdges()) {
+  for (const auto& edge : value.Edges()) {
     idx++;
     if (auto v = label_constraints_.Validate(
             ctx.ForIndexedSubVariable(edge_name, idx), edge.e);
@@ -336,32 +495,14 @@ ValidationResult Connected::Validate(
                 .details = "a graph with 0 nodes is not considered connected"});
   }
 
-  class UnionFind {
-   public:
-    UnionFind(int size) : parent_(size) {
-      for (int i = 0; i < size; ++i) parent_[i] = i;
-    }
-
-    int find(int i) {
-      return parent_[i] = (parent_[i] == i ? i : find(parent_[i]));
-    }
-
-    void unite(int i, int j) {
-      int I = find(i);
-      int J = find(j);
-      if (I != J) parent_[I] = J;
-    }
-
-   private:
-    std::vector<int> parent_;
-  };
+  // Connected exactly when n - 1 edges join two different components.
+  moriarty_internal::DisjointSets sets(value.NumNodes());
+  int64_t num_joined = 0;
+  for (const auto& [u, v, _] : value.Edges()) num_joined += sets.Unite(u, v);
+  if (num_joined == value.NumNodes() - 1) return ValidationResult::Ok();
 
-  UnionFind uf(value.NumNodes());
-  auto edges = value.GetEdges();
-  for (const auto& [u, v, _] : edges) uf.unite(u, v);
-
-  for (int i = 1; i < value.NumNodes(); ++i)
-    if (uf.find(i) != uf.find(0)) {
+  for (int64_t i = 1; i < value.NumNodes(); ++i)
+    if (sets.Find(i) != sets.Find(0)) {
       return ctx.Violation(
           value,
           {
@@ -376,25 +517,20 @@ ValidationResult Connected::Validate(
 template <typename EdgeLabel, typename NodeLabel>
 ValidationResult NoParallelEdges::Validate(
     ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
-  std::set<std::pair<typename Graph<EdgeLabel, NodeLabel>::NodeIdx,
-                     typename Graph<EdgeLabel, NodeLabel>::NodeIdx>>
-      seen;
-  auto edges = value.GetEdges();
-  for (const auto& [u, v, _] : edges) {
-    if (!seen.emplace(u, v).second)
-      return ctx.Violation(
-          value, {
-                     .expected = "no parallel edges",
-                     .details = std::format(
-                         "parallel edges between nodes {} and {}", u, v),
-                 });
-    if (u != v && !seen.emplace(v, u).second)
-      return ctx.Violation(
-          value, {
-                     .expected = "no parallel edges",
-                     .details = std::format(
-                         "parallel edges between nodes {} and {}", v, u),
-                 });
+  // After sorting the edges (as unordered pairs), parallel edges are adjacent.
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  pairs.reserve(value.NumEdges());
+  for (const auto& [u, v, _] : value.Edges())
+    pairs.push_back(std::minmax<int64_t>(u, v));
+  std::ranges::sort(pairs);
+  if (auto it = std::ranges::adjacent_find(pairs); it != pairs.end()) {
+    return ctx.Violation(
+        value, {
+                   .expected = "no parallel edges",
+                   .details = std::format(
+                       "parallel edges between nodes {} and {}", it->first,
+                       it->second),
+               });
   }
   return ValidationResult::Ok();
 }
@@ -403,7 +539,7 @@ ValidationResult NoParallelEdges::Validate(
 template <typename EdgeLabel, typename NodeLabel>
 ValidationResult Loopless::Validate(
     ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
-  auto edges = value.GetEdges();
+  auto edges = value.Edges();
   for (const auto& [u, v, _] : edges) {
     if (u == v) {
       return ctx.Violation(
@@ -429,6 +565,185 @@ ValidationResult SimpleGraph::Validate(
   return ValidationResult::Ok();
 }
 
+// ====== Tree ======
+template <typename EdgeLabel, typename NodeLabel>
+ValidationResult Tree::Validate(
+    ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
+  const int64_t n = value.NumNodes();
+  if (n == 0) {
+    return ctx.Violation(
+        value, {.expected = "tree",
+                .details = "a graph with 0 nodes is not considered a tree"});
+  }
+  if (value.NumEdges() != n - 1) {
+    return ctx.Violation(
+        value,
+        {.expected = "tree",
+         .details = std::format("a tree with {} nodes has {} edges, but got {}",
+                                n, n - 1, value.NumEdges())});
+  }
+
+  // With n - 1 edges, having no cycles is the same as being connected.
+  moriarty_internal::DisjointSets sets(n);
+  std::vector<int64_t> degree(n);
+  auto edges = value.Edges();
+  for (const auto& [u, v, _] : edges) {
+    if (!sets.Unite(u, v)) {
+      return ctx.Violation(
+          value,
+          {.expected = "tree",
+           .details = std::format("edge ({}, {}) completes a cycle", u, v)});
+    }
+    degree[u]++;
+    degree[v]++;
+  }
+
+  switch (shape_) {
+    case Shape::kAny:
+      break;
+    case Shape::kPath:
+      for (int64_t i = 0; i < n; i++) {
+        if (degree[i] > 2) {
+          return ctx.Violation(
+              value, {.expected = "path",
+                      .details = std::format("node {} has degree {}", i,
+                                             degree[i])});
+        }
+      }
+      break;
+    case Shape::kStar:
+      if (n > 2 && std::ranges::find(degree, n - 1) == degree.end()) {
+        return ctx.Violation(
+            value, {.expected = "star",
+                    .details = "no node is adjacent to every other node"});
+      }
+      break;
+    case Shape::kCaterpillar: {
+      // Removing the leaves leaves a path exactly when no non-leaf has more
+      // than 2 non-leaf neighbours.
+      std::vector<int64_t> inner_degree(n);
+      for (const auto& [u, v, _] : edges) {
+        if (degree[u] > 1 && degree[v] > 1) {
+          if (++inner_degree[u] > 2 || ++inner_degree[v] > 2) {
+            return ctx.Violation(
+                value,
+                {.expected = "caterpillar",
+                 .details = std::format(
+                     "node {} has more than 2 neighbours that are not leaves",
+                     inner_degree[u] > 2 ? u : v)});
+          }
+        }
+      }
+      break;
+    }
+  }
+  return ValidationResult::Ok();
+}
+
+// ====== Forest ======
+template <typename EdgeLabel, typename NodeLabel>
+ValidationResult Forest::Validate(
+    ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
+  moriarty_internal::DisjointSets sets(value.NumNodes());
+  auto edges = value.Edges();
+  for (const auto& [u, v, _] : edges) {
+    if (!sets.Unite(u, v)) {
+      return ctx.Violation(
+          value,
+          {.expected = "forest",
+           .details = std::format("edge ({}, {}) completes a cycle", u, v)});
+    }
+  }
+  auto v = num_trees_.Validate(ctx.ForSubVariable("number of trees"),
+                               value.NumNodes() - value.NumEdges());
+  if (v.IsOk()) return ValidationResult::Ok();
+  return ctx.Violation(value, std::move(v));
+}
+
+// ====== Bipartite ======
+template <typename EdgeLabel, typename NodeLabel>
+ValidationResult Bipartite::Validate(
+    ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
+  auto edges = value.Edges();
+  if (sides_) {
+    auto [num_left, num_right] = *sides_;
+    if (value.NumNodes() != num_left + num_right) {
+      return ctx.Violation(
+          value, {.expected = std::format("{} + {} nodes", num_left, num_right),
+                  .details = std::format("got {} nodes", value.NumNodes())});
+    }
+    for (const auto& [u, v, _] : edges) {
+      if ((u < num_left) == (v < num_left)) {
+        return ctx.Violation(
+            value,
+            {.expected = "bipartite graph",
+             .details = std::format("nodes {} and {} are on the same side", u,
+                                    v)});
+      }
+    }
+    return ValidationResult::Ok();
+  }
+
+  // Node x's two sides are x and x + n. An edge (u, v) puts u and v on
+  // opposite sides, which is impossible if they are already on the same one.
+  const int64_t n = value.NumNodes();
+  moriarty_internal::DisjointSets sides(2 * n);
+  for (const auto& [u, v, _] : edges) {
+    if (sides.Find(u) == sides.Find(v)) {
+      return ctx.Violation(
+          value, {.expected = "bipartite graph",
+                  .details = std::format(
+                      "edge ({}, {}) completes an odd-length cycle", u, v)});
+    }
+    sides.Unite(u, v + n);
+    sides.Unite(u + n, v);
+  }
+  return ValidationResult::Ok();
+}
+
+// ====== Grid ======
+template <typename EdgeLabel, typename NodeLabel>
+ValidationResult Grid::Validate(
+    ConstraintContext ctx, const Graph<EdgeLabel, NodeLabel>& value) const {
+  const int64_t n = num_rows_ * num_cols_;
+  const int64_t m = num_rows_ * std::max<int64_t>(num_cols_ - 1, 0) +
+                    num_cols_ * std::max<int64_t>(num_rows_ - 1, 0);
+  std::string expected = std::format("{}x{} grid", num_rows_, num_cols_);
+  if (value.NumNodes() != n || value.NumEdges() != m) {
+    return ctx.Violation(
+        value, {.expected = expected,
+                .details = std::format(
+                    "expected {} nodes and {} edges, but got {} and {}", n, m,
+                    value.NumNodes(), value.NumEdges())});
+  }
+
+  // Cell x's edge to the right is 2x, its edge downwards is 2x + 1.
+  std::vector<bool> seen(2 * n);
+  auto edges = value.Edges();
+  for (const auto& [u, v, _] : edges) {
+    auto [a, b] = std::minmax(u, v);
+    int64_t idx;
+    if (b == a + 1 && b % num_cols_ != 0) {
+      idx = 2 * a;
+    } else if (b == a + num_cols_) {
+      idx = 2 * a + 1;
+    } else {
+      return ctx.Violation(
+          value,
+          {.expected = expected,
+           .details = std::format("nodes {} and {} are not adjacent", u, v)});
+    }
+    if (seen[idx]) {
+      return ctx.Violation(
+          value, {.expected = expected,
+                  .details = std::format(
+                      "parallel edges between nodes {} and {}", u, v)});
+    }
+    seen[idx] = true;
+  }
+  return ValidationResult::Ok();
+}
+
 }  // namespace moriarty
 
 #endif  // MORIARTY_CONSTRAINTS_GRAPH_CONSTRAINTS_H_
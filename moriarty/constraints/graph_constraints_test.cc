@@ -14,9 +14,14 @@
 
 #include "moriarty/constraints/graph_constraints.h"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/librarian/errors.h"
 #include "moriarty/librarian/testing/gtest_helpers.h"
 #include "moriarty/types/graph.h"
 #include "moriarty/variables/minteger.h"
@@ -45,6 +50,17 @@ TEST(GraphConstraintsTest, ToStringLooksReasonable) {
   EXPECT_EQ(NoParallelEdges().ToString(), "is a graph with no parallel edges");
   EXPECT_EQ(Loopless().ToString(), "is a graph with no loops");
   EXPECT_EQ(SimpleGraph().ToString(), "is a simple graph");
+  EXPECT_EQ(Tree().ToString(), "is a tree");
+  EXPECT_EQ(Tree::Path().ToString(), "is a path");
+  EXPECT_EQ(Tree::Star().ToString(), "is a star");
+  EXPECT_EQ(Tree::Caterpillar().ToString(), "is a caterpillar tree");
+  EXPECT_EQ(Forest().ToString(), "is a forest");
+  EXPECT_EQ(Forest(3).ToString(),
+            "is a forest whose number of trees is exactly 3");
+  EXPECT_EQ(Bipartite().ToString(), "is a bipartite graph");
+  EXPECT_EQ(Bipartite(2, 3).ToString(),
+            "is a bipartite graph with sides of size 2 and 3");
+  EXPECT_EQ(Grid(2, 3).ToString(), "is a 2x3 grid graph");
   EXPECT_EQ(NodeLabels<MInteger>(Between(1, 10)).ToString(),
             "each node label is between 1 and 10");
   EXPECT_EQ(EdgeLabels<MInteger>(Between(1, 10)).ToString(),
@@ -77,6 +93,17 @@ TEST(GraphConstraintsTest, UnsatisfiedReasonLooksReasonable) {
   EXPECT_THAT(SimpleGraph().Validate(ctx, Graph(25).AddEdge(1, 1)),
               HasViolation(
                   AllOf(HasSubstr("expected: no loops"), HasSubstr("node 1"))));
+  EXPECT_THAT(Tree().Validate(ctx, Graph(3).AddEdge(0, 1)),
+              HasViolation(AllOf(HasSubstr("expected: tree"),
+                                 HasSubstr("has 2 edges, but got 1"))));
+  EXPECT_THAT(Forest().Validate(ctx, Graph(3).AddEdge(0, 1).AddEdge(1, 0)),
+              HasViolation(AllOf(HasSubstr("expected: forest"),
+                                 HasSubstr("edge (1, 0) completes a cycle"))));
+  EXPECT_THAT(Bipartite(1, 2).Validate(ctx, Graph(3).AddEdge(1, 2)),
+              HasViolation(HasSubstr("nodes 1 and 2 are on the same side")));
+  EXPECT_THAT(Grid(1, 3).Validate(ctx, Graph(3).AddEdge(0, 2).AddEdge(1, 2)),
+              HasViolation(AllOf(HasSubstr("expected: 1x3 grid"),
+                                 HasSubstr("nodes 0 and 2 are not adjacent"))));
 
   Graph<NoEdgeLabel, int64_t> graph_with_node_labels(3);
   graph_with_node_labels.SetNodeLabels({5, 10, 15});
@@ -160,6 +187,164 @@ TEST(GraphConstraintsTest, NumNodesAndNumEdgesSatisfiedWithWorks) {
               HasViolation(HasSubstr("number of edges")));
 }
 
+Graph<NoEdgeLabel, NoNodeLabel> GraphFromEdges(
+    int64_t num_nodes, std::vector<std::pair<int64_t, int64_t>> edges) {
+  Graph graph(num_nodes);
+  for (const auto& [u, v] : edges) graph.AddEdge(u, v);
+  return graph;
+}
+
+TEST(GraphConstraintsTest, ConnectedSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  EXPECT_THAT(Connected().Validate(ctx, Graph(1)), HasNoViolation());
+  EXPECT_THAT(Connected().Validate(ctx, GraphFromEdges(3, {{0, 1}, {2, 1}})),
+              HasNoViolation());
+  EXPECT_THAT(Connected().Validate(
+                  ctx, GraphFromEdges(4, {{0, 1}, {1, 0}, {2, 3}, {3, 3}})),
+              HasViolation(HasSubstr("node 2 is not connected to node 0")));
+}
+
+TEST(GraphConstraintsTest, ConnectedShouldHandleLongPaths) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  constexpr int64_t kNumNodes = 1'000'000;
+  Graph path(kNumNodes);
+  for (int64_t i = kNumNodes - 1; i > 0; i--) path.AddEdge(i - 1, i);
+  EXPECT_THAT(Connected().Validate(ctx, path), HasNoViolation());
+}
+
+TEST(GraphConstraintsTest, NoParallelEdgesSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  EXPECT_THAT(NoParallelEdges().Validate(
+                  ctx, GraphFromEdges(3, {{0, 1}, {1, 2}, {2, 0}, {1, 1}})),
+              HasNoViolation());
+  EXPECT_THAT(
+      NoParallelEdges().Validate(ctx, GraphFromEdges(3, {{0, 2}, {2, 0}})),
+      HasViolation(HasSubstr("nodes 0 and 2")));
+  EXPECT_THAT(
+      NoParallelEdges().Validate(ctx, GraphFromEdges(3, {{1, 1}, {1, 1}})),
+      HasViolation(HasSubstr("nodes 1 and 1")));
+}
+
+TEST(GraphConstraintsTest, TreeSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  EXPECT_THAT(Tree().Validate(ctx, Graph(1)), HasNoViolation());
+  EXPECT_THAT(Tree().Validate(ctx, GraphFromEdges(4, {{0, 1}, {2, 1}, {1, 3}})),
+              HasNoViolation());
+  EXPECT_THAT(Tree().Validate(ctx, Graph(0)), HasViolation(HasSubstr("0")));
+  EXPECT_THAT(Tree().Validate(ctx, GraphFromEdges(4, {{0, 1}, {1, 0}, {2, 3}})),
+              HasViolation(HasSubstr("cycle")));
+  EXPECT_THAT(Tree().Validate(ctx, GraphFromEdges(2, {{1, 1}})),
+              HasViolation(HasSubstr("cycle")));
+
+  auto star = GraphFromEdges(4, {{0, 1}, {2, 1}, {1, 3}});
+  auto path = GraphFromEdges(4, {{0, 2}, {2, 1}, {3, 1}});
+  // 0 - 1 - 2 - 3 spine, with leaves 4, 5 on 1 and 6 on 3.
+  auto caterpillar = GraphFromEdges(
+      7, {{0, 1}, {1, 2}, {2, 3}, {1, 4}, {5, 1}, {3, 6}});
+  // A spider with three legs of length 2.
+  auto spider = GraphFromEdges(
+      7, {{0, 1}, {1, 2}, {0, 3}, {3, 4}, {0, 5}, {5, 6}});
+
+  EXPECT_THAT(Tree::Path().Validate(ctx, path), HasNoViolation());
+  EXPECT_THAT(Tree::Path().Validate(ctx, star),
+              HasViolation(HasSubstr("node 1 has degree 3")));
+  EXPECT_THAT(Tree::Star().Validate(ctx, star), HasNoViolation());
+  EXPECT_THAT(Tree::Star().Validate(ctx, GraphFromEdges(2, {{0, 1}})),
+              HasNoViolation());
+  EXPECT_THAT(Tree::Star().Validate(ctx, path),
+              HasViolation(HasSubstr("star")));
+  EXPECT_THAT(Tree::Caterpillar().Validate(ctx, caterpillar), HasNoViolation());
+  EXPECT_THAT(Tree::Caterpillar().Validate(ctx, path), HasNoViolation());
+  EXPECT_THAT(Tree::Caterpillar().Validate(ctx, star), HasNoViolation());
+  EXPECT_THAT(Tree::Caterpillar().Validate(ctx, spider),
+              HasViolation(HasSubstr("node 0")));
+}
+
+TEST(GraphConstraintsTest, ForestSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  auto two_trees = GraphFromEdges(5, {{0, 1}, {2, 1}, {3, 4}});
+  EXPECT_THAT(Forest().Validate(ctx, Graph(0)), HasNoViolation());
+  EXPECT_THAT(Forest().Validate(ctx, two_trees), HasNoViolation());
+  EXPECT_THAT(Forest(2).Validate(ctx, two_trees), HasNoViolation());
+  EXPECT_THAT(Forest(Between(3, 5)).Validate(ctx, two_trees),
+              HasViolation(HasSubstr("number of trees")));
+  EXPECT_THAT(
+      Forest().Validate(ctx, GraphFromEdges(3, {{0, 1}, {1, 2}, {2, 0}})),
+      HasViolation(HasSubstr("cycle")));
+  EXPECT_THAT(Forest().Validate(ctx, GraphFromEdges(3, {{2, 2}})),
+              HasViolation(HasSubstr("cycle")));
+}
+
+TEST(GraphConstraintsTest, ForestDependenciesWork) {
+  EXPECT_THAT(Forest().GetDependencies(), IsEmpty());
+  EXPECT_THAT(Forest(Between(1, "K")).GetDependencies(), ElementsAre("K"));
+}
+
+TEST(GraphConstraintsTest, BipartiteSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  auto even_cycle = GraphFromEdges(4, {{0, 1}, {1, 2}, {2, 3}, {3, 0}});
+  auto odd_cycle = GraphFromEdges(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}});
+  EXPECT_THAT(Bipartite().Validate(ctx, even_cycle), HasNoViolation());
+  EXPECT_THAT(Bipartite().Validate(ctx, Graph(3)), HasNoViolation());
+  EXPECT_THAT(Bipartite().Validate(ctx, odd_cycle),
+              HasViolation(HasSubstr("odd-length cycle")));
+  EXPECT_THAT(Bipartite().Validate(ctx, GraphFromEdges(2, {{1, 1}})),
+              HasViolation(HasSubstr("odd-length cycle")));
+
+  auto left_to_right = GraphFromEdges(5, {{0, 2}, {3, 1}, {1, 4}, {0, 4}});
+  EXPECT_THAT(Bipartite(2, 3).Validate(ctx, left_to_right), HasNoViolation());
+  EXPECT_THAT(Bipartite(3, 2).Validate(ctx, left_to_right),
+              HasViolation(HasSubstr("same side")));
+  EXPECT_THAT(Bipartite(2, 2).Validate(ctx, left_to_right),
+              HasViolation(HasSubstr("got 5 nodes")));
+  EXPECT_THROW(Bipartite(-1, 2), InvalidConstraint);
+}
+
+TEST(GraphConstraintsTest, GridSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  // 0 1 2
+  // 3 4 5
+  auto grid = GraphFromEdges(
+      6, {{0, 1}, {2, 1}, {3, 4}, {4, 5}, {0, 3}, {4, 1}, {2, 5}});
+  EXPECT_THAT(Grid(2, 3).Validate(ctx, grid), HasNoViolation());
+  EXPECT_THAT(Grid(0, 3).Validate(ctx, Graph(0)), HasNoViolation());
+  EXPECT_THAT(Grid(3, 2).Validate(ctx, grid),
+              HasViolation(HasSubstr("not adjacent")));
+  EXPECT_THAT(Grid(2, 3).Validate(
+                  ctx, GraphFromEdges(6, {{0, 1}, {2, 1}, {3, 4}, {4, 5},
+                                          {0, 3}, {4, 1}, {1, 0}})),
+              HasViolation(HasSubstr("parallel edges")));
+  // 2 and 3 are consecutive, but not in the same row.
+  EXPECT_THAT(Grid(2, 3).Validate(
+                  ctx, GraphFromEdges(6, {{0, 1}, {2, 1}, {3, 4}, {4, 5},
+                                          {0, 3}, {4, 1}, {2, 3}})),
+              HasViolation(HasSubstr("not adjacent")));
+  EXPECT_THAT(Grid(2, 3).Validate(ctx, Graph(6)),
+              HasViolation(HasSubstr("expected 6 nodes and 7 edges")));
+  EXPECT_THROW(Grid(2, -3), InvalidConstraint);
+}
+
 TEST(GraphConstraintsTest, NodeAndEdgeLabelsSatisfiedWithWorks) {
   moriarty_internal::VariableSet variables;
   moriarty_internal::ValueSet values;
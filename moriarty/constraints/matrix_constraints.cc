@@ -0,0 +1,62 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/constraints/matrix_constraints.h"
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/librarian/dependencies.h"
+#include "moriarty/variables/minteger.h"
+
+namespace moriarty {
+
+// ====== NumRows ======
+NumRows::NumRows(int64_t num_rows) : num_rows_(Exactly(num_rows)) {}
+
+NumRows::NumRows(std::string_view expression)
+    : num_rows_(Exactly(expression)) {}
+
+MInteger NumRows::GetConstraints() const { return num_rows_; }
+
+std::string NumRows::ToString() const {
+  return std::format("is a matrix whose number of rows {}",
+                     num_rows_.ToString());
+}
+
+Dependencies NumRows::GetDependencies() const {
+  return num_rows_.GetDependencies();
+}
+
+// ====== NumCols ======
+NumCols::NumCols(int64_t num_cols) : num_cols_(Exactly(num_cols)) {}
+
+NumCols::NumCols(std::string_view expression)
+    : num_cols_(Exactly(expression)) {}
+
+MInteger NumCols::GetConstraints() const { return num_cols_; }
+
+std::string NumCols::ToString() const {
+  return std::format("is a matrix whose number of columns {}",
+                     num_cols_.ToString());
+}
+
+Dependencies NumCols::GetDependencies() const {
+  return num_cols_.GetDependencies();
+}
+
+}  // namespace moriarty
@@ -0,0 +1,140 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_CONSTRAINTS_MATRIX_CONSTRAINTS_H_
+#define MORIARTY_CONSTRAINTS_MATRIX_CONSTRAINTS_H_
+
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "moriarty/constraints/base_constraints.h"
+#include "moriarty/constraints/constraint_violation.h"
+#include "moriarty/context.h"
+#include "moriarty/librarian/dependencies.h"
+#include "moriarty/types/matrix.h"
+#include "moriarty/variables/minteger.h"
+
+namespace moriarty {
+
+// Constrains the number of rows in a matrix.
+class NumRows : public MConstraint {
+ public:
+  // The matrix must have exactly this many rows.
+  explicit NumRows(int64_t num_rows);
+
+  // The number of rows in the matrix must be exactly this integer expression.
+  // E.g., NumRows("3 * N + 1").
+  explicit NumRows(std::string_view expression);
+
+  // The number of rows in the matrix must satisfy all of these constraints.
+  // E.g., NumRows(Between(1, 10), Prime())
+  template <typename... Constraints>
+    requires(std::constructible_from<MInteger, Constraints...> &&
+             sizeof...(Constraints) > 0)
+  explicit NumRows(Constraints&&... constraints);
+
+  // Returns the constraints on the number of rows.
+  [[nodiscard]] MInteger GetConstraints() const;
+
+  // Determines if the matrix has the correct number of rows.
+  template <typename T>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Matrix<T>& value) const;
+
+  // Returns a string representation of this constraint.
+  [[nodiscard]] std::string ToString() const;
+
+  // Returns all variables that this constraint depends on.
+  Dependencies GetDependencies() const;
+
+ private:
+  MInteger num_rows_;
+};
+
+// Constrains the number of columns in a matrix.
+class NumCols : public MConstraint {
+ public:
+  // The matrix must have exactly this many columns.
+  explicit NumCols(int64_t num_cols);
+
+  // The number of columns in the matrix must be exactly this integer
+  // expression. E.g., NumCols("3 * N + 1").
+  explicit NumCols(std::string_view expression);
+
+  // The number of columns in the matrix must satisfy all of these constraints.
+  // E.g., NumCols(Between(1, 10), Prime())
+  template <typename... Constraints>
+    requires(std::constructible_from<MInteger, Constraints...> &&
+             sizeof...(Constraints) > 0)
+  explicit NumCols(Constraints&&... constraints);
+
+  // Returns the constraints on the number of columns.
+  [[nodiscard]] MInteger GetConstraints() const;
+
+  // Determines if the matrix has the correct number of columns.
+  template <typename T>
+  ValidationResult Validate(ConstraintContext ctx,
+                            const Matrix<T>& value) const;
+
+  // Returns a string representation of this constraint.
+  [[nodiscard]] std::string ToString() const;
+
+  // Returns all variables that this constraint depends on.
+  Dependencies GetDependencies() const;
+
+ private:
+  MInteger num_cols_;
+};
+
+// ----------------------------------------------------------------------------
+//  Template Implementation Below
+
+template <typename... Constraints>
+  requires(std::constructible_from<MInteger, Constraints...> &&
+           sizeof...(Constraints) > 0)
+NumRows::NumRows(Constraints&&... constraints)
+    : num_rows_(std::forward<Constraints>(constraints)...) {}
+
+template <typename... Constraints>
+  requires(std::constructible_from<MInteger, Constraints...> &&
+           sizeof...(Constraints) > 0)
+NumCols::NumCols(Constraints&&... constraints)
+    : num_cols_(std::forward<Constraints>(constraints)...) {}
+
+// ====== NumRows ======
+template <typename T>
+ValidationResult NumRows::Validate(ConstraintContext ctx,
+                                   const Matrix<T>& value) const {
+  auto v = num_rows_.Validate(ctx.ForSubVariable("number of rows"),
+                              value.NumRows());
+  if (v.IsOk()) return ValidationResult::Ok();
+  return ctx.Violation(value, std::move(v));
+}
+
+// ====== NumCols ======
+template <typename T>
+ValidationResult NumCols::Validate(ConstraintContext ctx,
+                                   const Matrix<T>& value) const {
+  auto v = num_cols_.Validate(ctx.ForSubVariable("number of columns"),
+                              value.NumCols());
+  if (v.IsOk()) return ValidationResult::Ok();
+  return ctx.Violation(value, std::move(v));
+}
+
+}  // namespace moriarty
+
+#endif  // MORIARTY_CONSTRAINTS_MATRIX_CONSTRAINTS_H_
@@ -0,0 +1,102 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/constraints/matrix_constraints.h"
+
+#include <cstdint>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/librarian/testing/gtest_helpers.h"
+#include "moriarty/types/matrix.h"
+#include "moriarty/variables/minteger.h"
+
+namespace moriarty {
+namespace {
+
+using ::moriarty_testing::Context;
+using ::moriarty_testing::GeneratedValuesAre;
+using ::moriarty_testing::HasNoViolation;
+using ::moriarty_testing::HasViolation;
+using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::Ge;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Le;
+
+// These aren't really tests, moreso to check for visual consistency.
+TEST(MatrixConstraintsTest, ToStringLooksReasonable) {
+  EXPECT_EQ(NumRows(Between(1, 10)).ToString(),
+            "is a matrix whose number of rows is between 1 and 10");
+  EXPECT_EQ(NumCols(Between(1, 10)).ToString(),
+            "is a matrix whose number of columns is between 1 and 10");
+}
+
+TEST(MatrixConstraintsTest, UnsatisfiedReasonLooksReasonable) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  EXPECT_THAT(NumRows(Between(1, 10)).Validate(ctx, Matrix<int64_t>(25, 3)),
+              HasViolation(
+                  AllOf(HasSubstr("number of rows"), HasSubstr("too large"))));
+  EXPECT_THAT(NumCols(Between(1, 10)).Validate(ctx, Matrix<int64_t>(3, 0)),
+              HasViolation(AllOf(HasSubstr("number of columns"),
+                                 HasSubstr("too small"))));
+}
+
+TEST(MatrixConstraintsTest, NumRowsAndColsGetConstraintsAreCorrect) {
+  EXPECT_THAT(NumRows(10).GetConstraints(), GeneratedValuesAre(10));
+  EXPECT_THAT(NumRows("2 * N").GetConstraints(),
+              GeneratedValuesAre(14, Context().WithValue<MInteger>("N", 7)));
+  EXPECT_THAT(NumRows(AtLeast("X"), AtMost(15)).GetConstraints(),
+              GeneratedValuesAre(AllOf(Ge(3), Le(15)),
+                                 Context().WithValue<MInteger>("X", 3)));
+
+  EXPECT_THAT(NumCols(10).GetConstraints(), GeneratedValuesAre(10));
+  EXPECT_THAT(NumCols("2 * N").GetConstraints(),
+              GeneratedValuesAre(14, Context().WithValue<MInteger>("N", 7)));
+  EXPECT_THAT(NumCols(AtLeast("X"), AtMost(15)).GetConstraints(),
+              GeneratedValuesAre(AllOf(Ge(3), Le(15)),
+                                 Context().WithValue<MInteger>("X", 3)));
+}
+
+TEST(MatrixConstraintsTest, NumRowsAndColsDependenciesWork) {
+  EXPECT_THAT(NumRows(Between(1, 10)).GetDependencies(), IsEmpty());
+  EXPECT_THAT(NumCols(Between(1, 10)).GetDependencies(), IsEmpty());
+  EXPECT_THAT(NumRows(Between(1, "3 * N + 1")).GetDependencies(),
+              ElementsAre("N"));
+  EXPECT_THAT(NumCols(Between(1, "3 * N + 1")).GetDependencies(),
+              ElementsAre("N"));
+}
+
+TEST(MatrixConstraintsTest, NumRowsAndColsSatisfiedWithWorks) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  ConstraintContext ctx("G", variables, values);
+
+  EXPECT_THAT(NumRows(Between(1, 100)).Validate(ctx, Matrix<int64_t>(5, 300)),
+              HasNoViolation());
+  EXPECT_THAT(NumRows(Between(1, 100)).Validate(ctx, Matrix<int64_t>(150, 3)),
+              HasViolation(HasSubstr("number of rows")));
+  EXPECT_THAT(NumCols(Between(1, 100)).Validate(ctx, Matrix<int64_t>(500, 3)),
+              HasNoViolation());
+  EXPECT_THAT(NumCols(Between(1, 100)).Validate(ctx, Matrix<int64_t>(5, 105)),
+              HasViolation(HasSubstr("number of columns")));
+}
+
+}  // namespace
+}  // namespace moriarty
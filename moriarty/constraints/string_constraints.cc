@@ -15,7 +15,9 @@
 
 #include "moriarty/constraints/string_constraints.h"
 
-#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <string>
@@ -43,11 +45,34 @@ constexpr static std::string_view kUpperAlphanumeric =
 constexpr static std::string_view kLowerAlphanumeric =
     "abcdefghijklmnopqrstuvwxyz0123456789";
 
+// Returns the index of the first character in `value` whose entry in `table`
+// is false, or std::string_view::npos if there is none.
+size_t FindFirstNotIn(const std::array<bool, 256>& table,
+                      std::string_view value) {
+  // Blocks of characters are checked without branching on each character (so
+  // the compiler may vectorize it). Only a block with a bad character is
+  // scanned again to find it.
+  static constexpr size_t kBlockSize = 64;
+  size_t idx = 0;
+  for (; idx + kBlockSize <= value.size(); idx += kBlockSize) {
+    bool all_valid = true;
+    for (size_t i = idx; i < idx + kBlockSize; i++)
+      all_valid &= table[static_cast<unsigned char>(value[i])];
+    if (!all_valid) break;
+  }
+  for (; idx < value.size(); idx++) {
+    if (!table[static_cast<unsigned char>(value[idx])]) return idx;
+  }
+  return std::string_view::npos;
+}
+
 }  // namespace
 
 // ====== Alphabet ======
 
-Alphabet::Alphabet(std::string_view alphabet) : alphabet_(alphabet) {}
+Alphabet::Alphabet(std::string_view alphabet) : alphabet_(alphabet) {
+  for (char c : alphabet_) in_alphabet_[static_cast<unsigned char>(c)] = true;
+}
 
 std::string Alphabet::GetAlphabet() const { return alphabet_; }
 
@@ -61,18 +86,13 @@ Alphabet Alphabet::LowerAlphanumeric() { return Alphabet(kLowerAlphanumeric); }
 
 ValidationResult Alphabet::Validate(ConstraintContext ctx,
                                     std::string_view value) const {
-  for (int idx = -1; char c : value) {
-    idx++;
-    if (alphabet_.find(c) == std::string::npos) {
-      return ctx.Violation(
-          value,
-          ValidationResult::Violation(
-              std::format("index {}", idx), c,
-              librarian::Expected("one of {}",
-                                  moriarty_internal::ValuePrinter(alphabet_))));
-    }
-  }
-  return ValidationResult::Ok();
+  size_t idx = FindFirstNotIn(in_alphabet_, value);
+  if (idx == std::string_view::npos) return ValidationResult::Ok();
+  return ctx.Violation(
+      value, ValidationResult::Violation(
+                 std::format("index {}", idx), value[idx],
+                 librarian::Expected(
+                     "one of {}", moriarty_internal::ValuePrinter(alphabet_))));
 }
 
 std::string Alphabet::ToString() const {
@@ -86,18 +106,18 @@ Dependencies Alphabet::GetDependencies() const { return {}; }
 
 ValidationResult DistinctCharacters::Validate(ConstraintContext ctx,
                                               std::string_view value) const {
-  std::array<int, (1 << 8) * sizeof(unsigned char)> seen;
-  std::fill(seen.begin(), seen.end(), -1);
-  for (int idx = -1; unsigned char c : value) {
-    idx++;
-    if (seen[static_cast<int>(c)] != -1) {
+  // Any string with more than 256 characters has a duplicate within its first
+  // 257 characters, so this loop is short.
+  std::bitset<256> seen;
+  for (size_t idx = 0; idx < value.size(); idx++) {
+    unsigned char c = value[idx];
+    if (seen[c]) {
       return ctx.Violation(
-          value,
-          ValidationResult::Violation(
-              std::format("indices {} and {}", seen[static_cast<int>(c)], idx),
-              c, librarian::Expected("distinct characters")));
+          value, ValidationResult::Violation(
+                     std::format("indices {} and {}", value.find(c), idx),
+                     c, librarian::Expected("distinct characters")));
     }
-    seen[static_cast<int>(c)] = idx;
+    seen[c] = true;
   }
   return ValidationResult::Ok();
 }
@@ -16,6 +16,7 @@
 #ifndef MORIARTY_CONSTRAINTS_STRING_CONSTRAINTS_H_
 #define MORIARTY_CONSTRAINTS_STRING_CONSTRAINTS_H_
 
+#include <array>
 #include <string>
 #include <string_view>
 
@@ -65,6 +66,7 @@ class Alphabet : public MConstraint {
 
  private:
   std::string alphabet_;
+  std::array<bool, 256> in_alphabet_ = {};  // Indexed by `unsigned char`.
 };
 
 // Constraint stating that the characters in the string must all be distinct.
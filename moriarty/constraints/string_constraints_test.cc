@@ -15,6 +15,8 @@
 
 #include "moriarty/constraints/string_constraints.h"
 
+#include <format>
+#include <string>
 #include <unordered_set>
 
 #include "gmock/gmock.h"
@@ -155,6 +157,25 @@ TEST(AlphabetTest, IsSatisfiedWithShouldWork) {
   }
 }
 
+TEST(AlphabetTest, ValidateShouldReportTheFirstInvalidIndex) {
+  Context context;
+  ConstraintContext ctx("test", context.Variables(), context.Values());
+
+  EXPECT_THAT(Alphabet("abc").Validate(ctx, std::string(1000, 'b')),
+              HasNoViolation());
+  // Positions on either side of the internal block boundaries.
+  for (int idx : {0, 1, 62, 63, 64, 65, 127, 128, 500, 998, 999}) {
+    std::string value(1000, 'a');
+    value[idx] = 'x';
+    value[999] = 'y';
+    EXPECT_THAT(Alphabet("abc").Validate(ctx, value),
+                HasViolation(std::format("index {}", idx)));
+  }
+  EXPECT_THAT(Alphabet("abc").Validate(ctx, "ab\xff"),
+              HasViolation("index 2"));
+  EXPECT_THAT(Alphabet("ab\xff").Validate(ctx, "ab\xff"), HasNoViolation());
+}
+
 TEST(AlphabetTest, ToStringShouldWork) {
   EXPECT_EQ(Alphabet("abc").ToString(), "contains only the characters \"abc\"");
   EXPECT_EQ(Alphabet("AbC").ToString(), "contains only the characters \"AbC\"");
@@ -180,6 +201,23 @@ TEST(DistinctCharactersTest, IsSatisfiedWithShouldWork) {
   EXPECT_THAT(DistinctCharacters().Validate(ctx, "abcABC"), HasNoViolation());
 }
 
+TEST(DistinctCharactersTest, ValidateShouldReportTheFirstDuplicate) {
+  Context context;
+  ConstraintContext ctx("test", context.Variables(), context.Values());
+
+  EXPECT_THAT(DistinctCharacters().Validate(ctx, "abcdb"),
+              HasViolation("indices 1 and 4"));
+  EXPECT_THAT(DistinctCharacters().Validate(ctx, "abcdcb"),
+              HasViolation("indices 2 and 4"));
+
+  std::string all_characters;
+  for (int c = 0; c < 256; c++) all_characters.push_back(c);
+  EXPECT_THAT(DistinctCharacters().Validate(ctx, all_characters),
+              HasNoViolation());
+  EXPECT_THAT(DistinctCharacters().Validate(ctx, all_characters + "A"),
+              HasViolation("indices 65 and 256"));
+}
+
 TEST(DistinctCharactersTest, ToStringShouldWork) {
   EXPECT_EQ(DistinctCharacters().ToString(), "has distinct characters");
 }
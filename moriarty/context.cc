@@ -14,6 +14,7 @@
 
 #include "moriarty/context.h"
 
+#include <ostream>
 #include <unordered_map>
 #include <utility>
 
@@ -95,8 +96,10 @@ ConstraintContext ConstraintContext::ForIndexedSubVariable(
 
 AnalyzeContext::AnalyzeContext(
     Ref<const moriarty_internal::VariableSet> variables,
-    Ref<const moriarty_internal::ValueSet> values)
-    : ViewOnlyContext(variables, values) {}
+    Ref<const moriarty_internal::ValueSet> values, Ref<std::ostream> os)
+    : ViewOnlyContext(variables, values), os_(os) {}
+
+std::ostream& AnalyzeContext::Output() const { return os_.get(); }
 
 void ValidationResults::AddFailure(int case_num, std::string reason) {
   failures_.emplace_back(case_num, std::move(reason));
@@ -109,6 +112,7 @@ std::string ValidationResults::DescribeFailures() const {
 
   std::string result;
   for (const auto& [case_num, reason] : failures_) {
+    if (!result.empty()) result += "\n";
     if (case_num != 0)
       result += std::format("Case #{} invalid:\n{}", case_num, reason);
     else
@@ -147,6 +147,11 @@ struct ReadOptions {
 
   // After reading is complete, how should we validate the test cases?
   ValidationStyle validation = ValidationStyle::kAllVariables;
+
+  // How many threads to validate with. Independent test cases (or, if there is
+  // only one test case, independent variables) are validated concurrently. If
+  // this is not positive, the number of hardware threads is used.
+  int num_threads = 1;
 };
 
 // -----------------------------------------------------------------------------
@@ -265,11 +270,22 @@ class ConstraintContext : public moriarty_internal::NameContext,
 class AnalyzeContext : public moriarty_internal::ViewOnlyContext {
  public:
   AnalyzeContext(Ref<const moriarty_internal::VariableSet> variables,
-                 Ref<const moriarty_internal::ValueSet> values);
+                 Ref<const moriarty_internal::ValueSet> values,
+                 Ref<std::ostream> os = std::cout);
+
+  // Output()
+  //
+  // Where the analyzer should write its results. If analyzers run
+  // concurrently, each gets its own buffer and the buffers are emitted in the
+  // order the analyzers were added.
+  [[nodiscard]] std::ostream& Output() const;
 
   // ********************************************
   // ** See parent classes for more functions. **
   // ********************************************
+
+ private:
+  Ref<std::ostream> os_;
 };
 
 // ----------------------------------------------------------------------------
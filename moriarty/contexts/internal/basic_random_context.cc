@@ -15,10 +15,13 @@
 
 #include "moriarty/contexts/internal/basic_random_context.h"
 
+#include <bit>
 #include <cstdint>
 #include <format>
 #include <limits>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 #include "moriarty/librarian/util/ref.h"
 
@@ -85,6 +88,59 @@ double BasicRandomContext::RandomReal(double n) {
   return std::ldexp(static_cast<double>(k), -digits) * n;
 }
 
+std::string BasicRandomContext::RandomString(std::string_view alphabet,
+                                             int64_t length) {
+  if (length < 0) {
+    throw std::invalid_argument(std::format(
+        "RandomString(<alphabet>, {}) is invalid (need length >= 0)", length));
+  }
+  if (alphabet.empty() && length > 0) {
+    throw std::invalid_argument(
+        std::format("RandomString(<empty_alphabet>, {}) is invalid (need "
+                    "nonempty alphabet)",
+                    length));
+  }
+
+  std::string result(length, alphabet.empty() ? '\0' : alphabet[0]);
+  const uint64_t k = alphabet.size();
+  if (k <= 1) return result;
+
+  if (std::has_single_bit(k)) {
+    // Each character is `bits` bits of a uniformly random 64-bit integer.
+    const int bits = std::countr_zero(k);
+    const int chars_per_draw = 64 / bits;
+    for (int64_t i = 0; i < length;) {
+      uint64_t draw = static_cast<uint64_t>(RandomInteger(
+          std::numeric_limits<int64_t>::min(),
+          std::numeric_limits<int64_t>::max()));
+      for (int j = 0; j < chars_per_draw && i < length; j++, draw >>= bits)
+        result[i++] = alphabet[draw & (k - 1)];
+    }
+    return result;
+  }
+
+  // Otherwise, each character is a base-k digit of a uniformly random integer
+  // in [0, k^chars_per_draw).
+  int chars_per_draw = 0;
+  uint64_t draw_size = 1;
+  while (draw_size <= std::numeric_limits<int64_t>::max() / k) {
+    draw_size *= k;
+    chars_per_draw++;
+  }
+  for (int64_t i = 0; i < length;) {
+    uint64_t size = draw_size;
+    int count = chars_per_draw;
+    if (length - i < chars_per_draw) {  // Don't waste randomness on the tail.
+      count = length - i;
+      size = 1;
+      for (int j = 0; j < count; j++) size *= k;
+    }
+    uint64_t draw = RandomInteger(0, size - 1);
+    for (int j = 0; j < count; j++, draw /= k) result[i++] = alphabet[draw % k];
+  }
+  return result;
+}
+
 std::vector<int> BasicRandomContext::RandomPermutation(int n) {
   if (n < 0) {
     throw std::invalid_argument(
@@ -22,6 +22,8 @@
 #include <iterator>
 #include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <unordered_set>
 
 #include "moriarty/internal/random_engine.h"
@@ -94,6 +96,15 @@ class BasicRandomContext {
   [[nodiscard]] std::vector<ElementType<Container>>
   RandomElementsWithReplacement(const Container& container, int k);
 
+  // RandomString()
+  //
+  // Returns a string of `length` characters, each chosen uniformly and
+  // independently from `alphabet`. Same distribution as
+  // RandomElementsWithReplacement(), but writes directly into the string and
+  // draws several characters from each random integer.
+  [[nodiscard]] std::string RandomString(std::string_view alphabet,
+                                         int64_t length);
+
   // RandomElementsWithoutReplacement()
   //
   // Returns k (randomly ordered) elements of `container`, without duplicates.
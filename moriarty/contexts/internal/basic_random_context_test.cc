@@ -18,6 +18,7 @@
 #include <map>
 #include <set>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -31,6 +32,7 @@ namespace {
 
 using ::moriarty_testing::Context;
 using ::testing::AllOf;
+using ::testing::AnyOf;
 using ::testing::AnyOfArray;
 using ::testing::Each;
 using ::testing::ElementsAre;
@@ -410,6 +412,58 @@ TEST(BasicRandomContextTest, RandomElementsAskingForTooManyDistinctShouldFail) {
       std::invalid_argument);
 }
 
+// -----------------------------------------------------------------------------
+//  RandomString()
+
+TEST(BasicRandomContextTest,
+     RandomStringGivesApproximatelyTheRightDistribution) {
+  Context test_ctx;
+  BasicRandomContext ctx(test_ctx.RandomEngine());
+
+  // Powers of two and other sizes are handled differently.
+  for (std::string alphabet : {"ab", "abc", "abcd", "0123456789abcdef",
+                               "abcdefghijklmnopqrstuvwxyz"}) {
+    std::string sample = ctx.RandomString(alphabet, 6000);
+    EXPECT_THAT(std::vector<char>(sample.begin(), sample.end()),
+                IsApproximatelyUniformlyRandom(alphabet.size()));
+  }
+}
+
+TEST(BasicRandomContextTest, RandomStringPairsShouldBeIndependent) {
+  Context test_ctx;
+  BasicRandomContext ctx(test_ctx.RandomEngine());
+
+  // Characters from the same random draw should not be correlated.
+  for (std::string alphabet : {"abc", "abcd"}) {
+    std::string sample = ctx.RandomString(alphabet, 12000);
+    std::vector<std::string> pairs;
+    for (int i = 0; i + 1 < sample.size(); i += 2)
+      pairs.push_back(sample.substr(i, 2));
+    EXPECT_THAT(pairs, IsApproximatelyUniformlyRandom(alphabet.size() *
+                                                      alphabet.size()));
+  }
+}
+
+TEST(BasicRandomContextTest, RandomStringHasTheRequestedLength) {
+  Context test_ctx;
+  BasicRandomContext ctx(test_ctx.RandomEngine());
+
+  for (int length : {0, 1, 12, 13, 14, 100}) {
+    EXPECT_THAT(ctx.RandomString("xyz", length),
+                AllOf(SizeIs(length), Each(AnyOf('x', 'y', 'z'))));
+  }
+  EXPECT_EQ(ctx.RandomString("q", 5), "qqqqq");
+  EXPECT_EQ(ctx.RandomString("", 0), "");
+}
+
+TEST(BasicRandomContextTest, RandomStringWithInvalidArgumentsShouldFail) {
+  Context test_ctx;
+  BasicRandomContext ctx(test_ctx.RandomEngine());
+
+  EXPECT_THROW({ (void)ctx.RandomString("abc", -1); }, std::invalid_argument);
+  EXPECT_THROW({ (void)ctx.RandomString("", 1); }, std::invalid_argument);
+}
+
 // -----------------------------------------------------------------------------
 //  RandomPermutation()
 
@@ -1,9 +1,13 @@
 #include "moriarty/contexts/internal/generation_orchestration_context.h"
 
+#include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 
+#include "moriarty/internal/range.h"
 #include "moriarty/librarian/util/ref.h"
 
 namespace moriarty {
@@ -26,9 +30,26 @@ void GenerationOrchestrationContext::MarkAbandonedGeneration() {
   handler_.get().Abandon();
 }
 
+void GenerationOrchestrationContext::MarkValueStored(
+    std::string_view variable_name) {
+  handler_.get().MarkValueStored(variable_name);
+}
+
 RetryRecommendation GenerationOrchestrationContext::ReportGenerationFailure(
-    std::string failure_reason) {
-  return handler_.get().ReportFailure(failure_reason);
+    std::string failure_reason,
+    std::optional<std::span<const std::string>> culprits) {
+  return handler_.get().ReportFailure(std::move(failure_reason), culprits);
+}
+
+std::optional<Range::ExtremeValues<int64_t>>
+GenerationOrchestrationContext::GetCachedIntegerExtremes(
+    const Range& range) const {
+  return handler_.get().GetCachedIntegerExtremes(range);
+}
+
+void GenerationOrchestrationContext::CacheIntegerExtremes(
+    const Range& range, Range::ExtremeValues<int64_t> extremes) {
+  handler_.get().CacheIntegerExtremes(range, extremes);
 }
 
 std::optional<std::string> GenerationOrchestrationContext::GetFailureReason(
@@ -15,9 +15,14 @@
 #ifndef MORIARTY_CONTEXTS_INTERNAL_GENERATION_ORCHESTRATION_CONTEXT_H_
 #define MORIARTY_CONTEXTS_INTERNAL_GENERATION_ORCHESTRATION_CONTEXT_H_
 
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 
 #include "moriarty/internal/generation_handler.h"
+#include "moriarty/internal/range.h"
 #include "moriarty/librarian/util/ref.h"
 
 namespace moriarty {
@@ -49,24 +54,50 @@ class GenerationOrchestrationContext {
   // started must have already finished as well.
   void MarkAbandonedGeneration();
 
+  // MarkValueStored()
+  //
+  // Informs the system that the value of `variable_name` has been stored. If a
+  // variable that is currently being generated fails, this value will be in
+  // its list of variables to delete.
+  void MarkValueStored(std::string_view variable_name);
+
   // ReportGenerationFailure()
   //
   // Informs the system that `variable_name` has failed to generate a value.
   // Returns a recommendation for if the variable should retry generation or
   // abort generation.
   //
-  // The list of variables to be deleted in the recommendation are those that
-  // were generated since this variable started its generation. This class will
-  // assume that the value for those variables have been deleted.
+  // The list of variables to be deleted in the recommendation are those whose
+  // values were stored since this variable started its generation. This class
+  // will assume that the value for those variables have been deleted.
+  //
+  // If `culprits` is set, only those variables (and anything that may depend
+  // on them) are considered to have caused the failure. See
+  // `GenerationHandler::ReportFailure()`.
   //
   // All variables that have started their generation since this one
   // started must have already finished as well.
   [[nodiscard]] RetryRecommendation ReportGenerationFailure(
-      std::string failure_reason);
+      std::string failure_reason,
+      std::optional<std::span<const std::string>> culprits = std::nullopt);
+
+  // GetCachedIntegerExtremes()
+  //
+  // Returns the extremes of `range` that were resolved earlier in this
+  // generation, if the values they depend on have not changed since.
+  [[nodiscard]] std::optional<Range::ExtremeValues<int64_t>>
+  GetCachedIntegerExtremes(const Range& range) const;
+
+  // CacheIntegerExtremes()
+  //
+  // Records the extremes of `range`, resolved using the current values.
+  void CacheIntegerExtremes(const Range& range,
+                            Range::ExtremeValues<int64_t> extremes);
 
   // GetFailureReason()
   //
-  // Returns the most recent failure reason for `variable_name`.
+  // Returns the most recent failure reason for `variable_name`, if it has ever
+  // failed.
   [[nodiscard]] std::optional<std::string> GetFailureReason(
       std::string variable_name) const;
 
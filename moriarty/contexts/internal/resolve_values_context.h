@@ -97,6 +97,7 @@ T::value_type ResolveValuesContext::GenerateVariable(
   auto value = variable.Generate(
       {variable_name, variables_, values_, engine_, handler_});
   values_.get().Set<T>(variable_name, value);
+  handler_.get().MarkValueStored(variable_name);
   return value;
 }
 
@@ -124,6 +125,7 @@ T::value_type ResolveValuesContext::GenerateVariable(
   auto value = extra_constraints.Generate(
       {variable_name, variables_, values_, engine_, handler_});
   values_.get().Set<T>(variable_name, value);
+  handler_.get().MarkValueStored(variable_name);
   return value;
 }
 
@@ -33,6 +33,7 @@ using ::testing::AllOf;
 using ::testing::Ge;
 using ::testing::Le;
 using ::testing::Throws;
+using ::testing::UnorderedElementsAre;
 
 TEST(ResolveValuesContextTest, GenerateVariableInHappyPathShouldWork) {
   {  // No extra constraints
@@ -139,6 +140,25 @@ TEST(ResolveValuesContextTest,
   EXPECT_EQ(result, X + Y);
 }
 
+TEST(ResolveValuesContextTest,
+     GeneratedVariablesShouldBeDiscardedWhenTheParentFails) {
+  Context context = Context()
+                        .WithVariable("X", MInteger(Between("N-1", "N")))
+                        .WithVariable("N", MInteger(Between(42, 42)))
+                        .WithVariable("Y", MInteger(Between(1, 1000)));
+  GenerationHandler handler;
+
+  handler.Start("Parent");
+  ResolveValuesContext ctx(context.Variables(), context.Values(),
+                           context.RandomEngine(), handler);
+  (void)ctx.GenerateVariable<MInteger>("X");
+  (void)ctx.GenerateVariable<MInteger>("Y", MInteger(Exactly(5)));
+
+  RetryRecommendation recommendation = handler.ReportFailure("Parent failed");
+  EXPECT_THAT(recommendation.variable_names_to_delete,
+              UnorderedElementsAre("X", "N", "Y"));
+}
+
 }  // namespace
 }  // namespace moriarty_internal
 }  // namespace moriarty
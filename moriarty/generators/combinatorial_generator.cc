@@ -15,8 +15,12 @@
 
 #include "moriarty/generators/combinatorial_generator.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +28,8 @@
 #include "moriarty/context.h"
 #include "moriarty/internal/abstract_variable.h"
 #include "moriarty/internal/combinatorial_coverage.h"
+#include "moriarty/internal/covering_array_cache.h"
+#include "moriarty/internal/random_engine.h"
 #include "moriarty/test_case.h"
 
 namespace moriarty {
@@ -68,13 +74,57 @@ std::vector<MTestCase> CreateTestCases(
 }  // namespace
 
 std::vector<MTestCase> CombinatorialCoverage(GenerateContext ctx) {
-  InitializeCasesInfo cases_info = InitializeCases(ctx);
-  auto rand_f = [&ctx](int n) { return ctx.RandomInteger(n); };
+  return CombinatorialCoverageWithOptions({})(ctx);
+}
+
+GenerateFn CombinatorialCoverageWithStrength(int strength) {
+  return CombinatorialCoverageWithOptions({.strength = strength});
+}
 
-  std::vector<CoveringArrayTestCase> covering_array = GenerateCoveringArray(
-      cases_info.dimension_sizes, cases_info.dimension_sizes.size(), rand_f);
-  return CreateTestCases(covering_array, cases_info.cases,
-                         cases_info.variable_names);
+GenerateFn CombinatorialCoverageWithOptions(
+    CombinatorialCoverageOptions options) {
+  if (options.strength && *options.strength <= 0) {
+    throw std::invalid_argument(
+        "CombinatorialCoverage: strength must be positive.");
+  }
+  return [options](GenerateContext ctx) -> std::vector<MTestCase> {
+    InitializeCasesInfo cases_info = InitializeCases(ctx);
+    const std::vector<int>& sizes = cases_info.dimension_sizes;
+    if (sizes.empty()) return {};
+
+    // Any explicit strength uses the in-parameter-order construction, even if
+    // it covers every variable (then it is the full product).
+    int n = sizes.size();
+    bool in_parameter_order = options.strength.has_value();
+    int strength = in_parameter_order ? std::min(*options.strength, n) : n;
+    auto build = [&](std::function<int(int)> rand) {
+      return in_parameter_order
+                 ? GenerateCoveringArrayInParameterOrder(sizes, strength, rand)
+                 : GenerateCoveringArray(sizes, strength, rand);
+    };
+
+    std::vector<CoveringArrayTestCase> covering_array;
+    if (!options.cache_directory) {
+      covering_array = build([&ctx](int n) { return ctx.RandomInteger(n); });
+    } else {
+      moriarty_internal::CoveringArrayCacheKey key = {
+          .algorithm = in_parameter_order ? "ipog" : "greedy",
+          .dimension_sizes = sizes,
+          .strength = strength,
+          .seed = ctx.RandomInteger(std::numeric_limits<int64_t>::max())};
+      if (auto cached = moriarty_internal::ReadCachedCoveringArray(
+              *options.cache_directory, key)) {
+        covering_array = *std::move(cached);
+      } else {
+        moriarty_internal::RandomEngine rng({key.seed}, "v0.1");
+        covering_array = build([&rng](int n) { return rng.RandInt(n); });
+        moriarty_internal::WriteCachedCoveringArray(*options.cache_directory,
+                                                    key, covering_array);
+      }
+    }
+    return CreateTestCases(covering_array, cases_info.cases,
+                           cases_info.variable_names);
+  };
 }
 
 }  // namespace moriarty
@@ -26,7 +26,21 @@
 //    .AddVariable("N", MInteger(Between(1, 10)))
 //    .AddVariable("A", MArray<MInteger>(Length("N")));
 // M.GenerateTestCases(CombinatorialCoverage);  // Will generate tricky cases.
+//
+// With many variables, every combination of their difficult instances is far
+// too many test cases. Instead, only cover every combination for each small
+// subset of the variables:
+//
+// M.GenerateTestCases(CombinatorialCoverageWithStrength(2));
+//
+// Building the covering array can be slow with many variables. To reuse it
+// between runs with the same variables and seed, cache it on disk:
+//
+// M.GenerateTestCases(CombinatorialCoverageWithOptions(
+//     {.strength = 3, .cache_directory = "/tmp/moriarty_cache"}));
 
+#include <filesystem>
+#include <optional>
 #include <vector>
 
 #include "moriarty/context.h"
@@ -38,6 +52,32 @@ namespace moriarty {
 // of the defined variables.
 std::vector<MTestCase> CombinatorialCoverage(GenerateContext ctx);
 
+// Returns a generator similar to `CombinatorialCoverage`, but which only
+// ensures that for every `strength` variables, every combination of their
+// difficult instances appears in some test case. `strength` must be positive.
+// If it is larger than the number of variables, every combination is used.
+GenerateFn CombinatorialCoverageWithStrength(int strength);
+
+struct CombinatorialCoverageOptions {
+  // If set, only ensures that for every `strength` variables, every
+  // combination of their difficult instances appears in some test case. Must
+  // be positive. If unset, every combination is used.
+  std::optional<int> strength;
+
+  // If set, covering arrays are cached in this directory, keyed by the number
+  // of difficult instances of each variable, the strength and the seed.
+  //
+  // When caching, the covering array is built from its own random stream,
+  // seeded by a single value drawn from the context, so the rest of the
+  // generation is identical whether or not the cache is hit.
+  std::optional<std::filesystem::path> cache_directory;
+};
+
+// Returns a generator similar to `CombinatorialCoverage`, configured by
+// `options`.
+GenerateFn CombinatorialCoverageWithOptions(
+    CombinatorialCoverageOptions options);
+
 }  // namespace moriarty
 
 #endif  // MORIARTY_GENERATORS_COMBINATORIAL_GENERATOR_H_
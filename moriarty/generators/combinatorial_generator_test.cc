@@ -15,6 +15,10 @@
 
 #include "moriarty/generators/combinatorial_generator.h"
 
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -36,6 +40,7 @@ using ::moriarty::CombinatorialCoverage;
 using ::moriarty::moriarty_internal::ValueSet;
 using ::moriarty_testing::Context;
 using ::moriarty_testing::MTestType;
+using ::testing::ElementsAre;
 
 namespace {
 
@@ -86,5 +91,106 @@ TEST(CombinatorialCoverage, GenerateShouldCreateCasesFromCoveringArray) {
               IsStrength2CoveringArray(std::vector<int>({2, 2})));
 }
 
+TEST(CombinatorialCoverage, GenerateWithStrengthShouldCoverEveryPair) {
+  Context context = Context()
+                        .WithVariable("X", MTestType())
+                        .WithVariable("Y", MTestType())
+                        .WithVariable("Z", MTestType());
+
+  moriarty_internal::RandomEngine rng({1, 2, 3, 4}, "v0.1");
+  std::unordered_map<std::string, std::string> args;
+  GenerateContext ctx(context.Variables(), context.Values(), rng, args);
+
+  std::vector<MTestCase> test_cases =
+      CombinatorialCoverageWithStrength(2)(ctx);
+  std::vector<CoveringArrayTestCase> cov_array;
+  for (const MTestCase& test_case : test_cases) {
+    ValueSet values = moriarty_internal::GenerateAllValues(
+        context.Variables(), test_case.UnsafeGetVariables(),
+        test_case.UnsafeGetValues(), {rng});
+    CoveringArrayTestCase catc;
+    for (const char* name : {"X", "Y", "Z"}) {
+      catc.test_case.push_back(
+          MapValueToTestCaseNumber(values.Get<MTestType>(name).value));
+    }
+    cov_array.push_back(catc);
+  }
+
+  EXPECT_THAT(cov_array, IsStrength2CoveringArray(std::vector<int>({2, 2, 2})));
+  EXPECT_LT(cov_array.size(), 8);
+}
+
+TEST(CombinatorialCoverage, StrengthCoveringEveryVariableShouldUseIpog) {
+  Context context =
+      Context().WithVariable("X", MTestType()).WithVariable("Y", MTestType());
+
+  moriarty_internal::RandomEngine rng({1, 2, 3, 4}, "v0.1");
+  std::unordered_map<std::string, std::string> args;
+  GenerateContext ctx(context.Variables(), context.Values(), rng, args);
+
+  // The in-parameter-order construction starts from every combination of the
+  // first `strength` variables in lexicographic order, and has nothing left to
+  // add when `strength` covers every variable.
+  std::vector<MTestCase> test_cases =
+      CombinatorialCoverageWithStrength(5)(ctx);
+  std::vector<ValueSet> generated_cases;
+  for (const MTestCase& test_case : test_cases) {
+    generated_cases.push_back(moriarty_internal::GenerateAllValues(
+        context.Variables(), test_case.UnsafeGetVariables(),
+        test_case.UnsafeGetValues(), {rng}));
+  }
+
+  std::vector<std::vector<int>> rows;
+  for (const CoveringArrayTestCase& row :
+       CasesToCoveringArray(generated_cases)) {
+    rows.push_back(row.test_case);
+  }
+  EXPECT_THAT(rows, ElementsAre(ElementsAre(0, 0), ElementsAre(0, 1),
+                                ElementsAre(1, 0), ElementsAre(1, 1)));
+}
+
+TEST(CombinatorialCoverage, CachedCoveringArraysShouldBeReused) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  ASSERT_NE(test_tmpdir, nullptr);
+  std::filesystem::path cache_directory =
+      std::filesystem::path(test_tmpdir) / "CachedCoveringArraysShouldBeReused";
+  std::filesystem::remove_all(cache_directory);
+
+  Context context = Context()
+                        .WithVariable("X", MTestType())
+                        .WithVariable("Y", MTestType())
+                        .WithVariable("Z", MTestType());
+  GenerateFn generator = CombinatorialCoverageWithOptions(
+      {.strength = 2, .cache_directory = cache_directory});
+
+  // Runs the generator with a fresh seed, then generates a few more values
+  // with the same random engine.
+  auto run = [&] {
+    moriarty_internal::RandomEngine rng({1, 2, 3, 4}, "v0.1");
+    std::unordered_map<std::string, std::string> args;
+    GenerateContext ctx(context.Variables(), context.Values(), rng, args);
+    std::vector<int> values;
+    for (const MTestCase& test_case : generator(ctx)) {
+      ValueSet generated = moriarty_internal::GenerateAllValues(
+          context.Variables(), test_case.UnsafeGetVariables(),
+          test_case.UnsafeGetValues(), {rng});
+      for (const char* name : {"X", "Y", "Z"})
+        values.push_back(generated.Get<MTestType>(name).value);
+    }
+    values.push_back(rng.RandInt(1000000));
+    return values;
+  };
+
+  std::vector<int> first = run();
+  ASSERT_TRUE(std::filesystem::exists(cache_directory));
+  EXPECT_FALSE(std::filesystem::is_empty(cache_directory));
+  EXPECT_EQ(run(), first);
+}
+
+TEST(CombinatorialCoverage, GenerateWithNonPositiveStrengthShouldThrow) {
+  EXPECT_THROW((void)CombinatorialCoverageWithStrength(0),
+               std::invalid_argument);
+}
+
 }  // namespace
 }  // namespace moriarty
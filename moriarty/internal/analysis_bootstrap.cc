@@ -15,7 +15,9 @@
 #include "moriarty/internal/analysis_bootstrap.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <format>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <string>
@@ -26,6 +28,7 @@
 #include "moriarty/constraints/constraint_violation.h"
 #include "moriarty/context.h"
 #include "moriarty/internal/abstract_variable.h"
+#include "moriarty/internal/parallel.h"
 #include "moriarty/internal/value_set.h"
 #include "moriarty/internal/variable_set.h"
 
@@ -48,10 +51,18 @@ bool ShouldValidateVariable(ValidationStyle validation,
 std::vector<DetailedValidationResult> ValidateValues(
     const VariableSet& variables, const ValueSet& values,
     std::span<const std::string> variables_to_validate,
-    ValidationStyle validation) {
+    ValidationStyle validation, int num_threads) {
   if (validation == ValidationStyle::kNone) return {};
 
-  std::vector<DetailedValidationResult> violations;
+  // One slot per variable, so the violations are reported in variable order no
+  // matter which thread finds them.
+  std::vector<std::optional<DetailedValidationResult>> slots;
+  struct PendingVariable {
+    int64_t slot;
+    std::string_view name;
+    const AbstractVariable* var;
+  };
+  std::vector<PendingVariable> to_validate;
   for (const auto& [name, var] : variables.ListVariables()) {
     if (!ShouldValidateVariable(validation, variables_to_validate, name))
       continue;
@@ -59,16 +70,29 @@ std::vector<DetailedValidationResult> ValidateValues(
     if (!values.Contains(name)) {
       if (validation == ValidationStyle::kAllVariables ||
           validation == ValidationStyle::kEverything) {
-        violations.push_back(
-            {name,
-             ValidationResult::Violation(
-                 name, librarian::Expected("should have a value assigned"))});
+        slots.push_back(DetailedValidationResult{
+            name,
+            ValidationResult::Violation(
+                name, librarian::Expected("should have a value assigned"))});
       }
       continue;
     }
+    to_validate.push_back({.slot = static_cast<int64_t>(slots.size()),
+                           .name = name,
+                           .var = var.get()});
+    slots.push_back(std::nullopt);
+  }
+
+  ParallelFor(to_validate.size(), num_threads, [&](int64_t i) {
+    const auto& [slot, name, var] = to_validate[i];
     if (auto v = var->Validate(name, variables, values); !v.IsOk()) {
-      violations.push_back({name, std::move(v)});
+      slots[slot] = DetailedValidationResult{std::string(name), std::move(v)};
     }
+  });
+
+  std::vector<DetailedValidationResult> violations;
+  for (auto& slot : slots) {
+    if (slot) violations.push_back(*std::move(slot));
   }
 
   if (validation == ValidationStyle::kOnlySetValues ||
@@ -37,10 +37,14 @@ namespace moriarty_internal {
 // If a value does not have a variable, this will return ok.
 //
 // If variables_to_validate is non-empty, only those variables will be checked.
+//
+// Variables are validated independently, using up to `num_threads` threads (if
+// this is not positive, the number of hardware threads is used). The results
+// are in the same order regardless of the number of threads.
 [[nodiscard]] std::vector<DetailedValidationResult> ValidateValues(
     const VariableSet& variables, const ValueSet& values,
     std::span<const std::string> variables_to_validate,
-    ValidationStyle validation);
+    ValidationStyle validation, int num_threads = 1);
 
 }  // namespace moriarty_internal
 }  // namespace moriarty
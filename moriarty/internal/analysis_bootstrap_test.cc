@@ -14,9 +14,14 @@
 
 #include "moriarty/internal/analysis_bootstrap.h"
 
+#include <format>
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/constraints/numeric_constraints.h"
 #include "moriarty/context.h"
 #include "moriarty/librarian/testing/gtest_helpers.h"
 #include "moriarty/librarian/testing/mtest_type.h"
@@ -32,6 +37,7 @@ using ::moriarty_testing::HasNoInvalidConstraints;
 using ::moriarty_testing::LastDigit;
 using ::moriarty_testing::MTestType;
 using ::moriarty_testing::TestType;
+using ::testing::ElementsAreArray;
 
 TEST(AnalysisBootstrapTest, ValidateValuesSucceedsWithNoVariables) {
   Context context;
@@ -126,6 +132,28 @@ TEST(AnalysisBootstrapTest, ValidateValuesWorksForDependentVariables) {
               HasNoInvalidConstraints());
 }
 
+TEST(AnalysisBootstrapTest, ValidateValuesWithManyThreadsShouldMatchOneThread) {
+  Context context;
+  for (int i = 0; i < 100; i++) {
+    std::string name = std::format("X{}", i);
+    context.WithVariable(name, MInteger(Between(1, 10)))
+        .WithValue<MInteger>(name, i % 7 == 0 ? 11 : 5);
+  }
+
+  auto names = [](const std::vector<DetailedValidationResult>& results) {
+    std::vector<std::string> names;
+    for (const auto& result : results) names.push_back(result.variable_name);
+    return names;
+  };
+  std::vector<std::string> expected =
+      names(ValidateValues(context.Variables(), context.Values(), {},
+                           ValidationStyle::kAllVariables, 1));
+  EXPECT_EQ(expected.size(), 15);
+  EXPECT_THAT(names(ValidateValues(context.Variables(), context.Values(), {},
+                                   ValidationStyle::kAllVariables, 8)),
+              ElementsAreArray(expected));
+}
+
 }  // namespace
 }  // namespace moriarty_internal
 }  // namespace moriarty
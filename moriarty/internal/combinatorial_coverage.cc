@@ -17,9 +17,14 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "absl/log/absl_check.h"
@@ -37,16 +42,79 @@ constexpr uint64_t ONE = 1;  // To avoid `(uint64_t)1 << val`
 using SerializedTestCase = int64_t;
 
 // Represents a subset of the columns and which (partial) test cases we have
-// covered in those columns. The `covered` array stores which of the
+// not yet covered in those columns. There are
 //
 //    `dim_1_size * dim_2_size * ... * dim_strength_size`
 //
-// partial test cases for this `column_mask` have been seen. The `covered` array
-// corresponds to the test cases in lexicographic order.
+// partial test cases for this `column_mask`, numbered in lexicographic order.
+//
+// Bit `x` of `covered` is set once partial test case `x` has been seen.
+// `candidates` holds (in no particular order) every uncovered partial test
+// case, plus some that have been covered since it was last compacted. It is
+// compacted whenever fewer than half of its entries are uncovered, so a random
+// uncovered case is found in O(1) expected draws.
 struct ColumnSet {
   BitMask column_mask;          // Which columns?
   int64_t remaining_uncovered;  // How many partial cases are not covered?
-  std::vector<bool> covered;    // Some case covers the serialized partial case.
+  std::vector<uint64_t> covered;
+  std::vector<int32_t> candidates;
+
+  int64_t RemainingUncovered() const { return remaining_uncovered; }
+  bool IsCovered(SerializedTestCase x) const {
+    return (covered[x / 64] >> (x % 64)) & ONE;
+  }
+};
+
+// Orders the column sets by the number of partial test cases they have left to
+// cover. Since that number only ever decreases by one at a time, the order is
+// maintained in O(1) per update (a bucket sort that is never re-sorted).
+//
+// `order` is sorted in increasing order of RemainingUncovered(), and
+// `bucket_start[c]` is the first index in `order` whose column set has at least
+// `c` remaining uncovered partial test cases.
+class ColumnSetPriority {
+ public:
+  explicit ColumnSetPriority(std::span<const ColumnSet> column_sets) {
+    int64_t max_remaining = 0;
+    for (const ColumnSet& column_set : column_sets)
+      max_remaining = std::max(max_remaining, column_set.RemainingUncovered());
+
+    // Counting sort. Ties are broken by index, for consistency across systems.
+    bucket_start_.assign(max_remaining + 2, 0);
+    for (const ColumnSet& column_set : column_sets)
+      bucket_start_[column_set.RemainingUncovered() + 1]++;
+    for (int64_t c = 1; c < bucket_start_.size(); c++)
+      bucket_start_[c] += bucket_start_[c - 1];
+
+    order_.resize(column_sets.size());
+    position_.resize(column_sets.size());
+    std::vector<int64_t> next(bucket_start_.begin(), bucket_start_.end() - 1);
+    for (int64_t i = 0; i < column_sets.size(); i++) {
+      int64_t pos = next[column_sets[i].RemainingUncovered()]++;
+      order_[pos] = i;
+      position_[i] = pos;
+    }
+  }
+
+  // Returns the indices of the column sets, from the most remaining uncovered
+  // partial test cases to the fewest.
+  auto MostUncoveredFirst() const { return std::views::reverse(order_); }
+
+  // Records that column set `idx`, which had `remaining` uncovered partial test
+  // cases, now has `remaining - 1`.
+  void Decrement(int64_t idx, int64_t remaining) {
+    // Swap `idx` to the front of its bucket, then shrink the bucket past it.
+    int64_t pos = position_[idx];
+    int64_t front = bucket_start_[remaining]++;
+    std::swap(order_[pos], order_[front]);
+    position_[order_[pos]] = pos;
+    position_[order_[front]] = front;
+  }
+
+ private:
+  std::vector<int64_t> order_;
+  std::vector<int64_t> position_;  // position_[i] is the index of i in order_.
+  std::vector<int64_t> bucket_start_;
 };
 
 // SerializePartialTestCase()
@@ -119,46 +187,37 @@ std::vector<BitMask> GetAllNChooseK(int n, int k) {
 //     cases.
 // (3) Repeat (2) until all columns have been covered.
 std::optional<CoveringArrayTestCase> FindTestCaseToAdd(
-    std::span<const ColumnSet> column_sets,
+    std::span<const ColumnSet> column_sets, const ColumnSetPriority& priority,
     std::span<const int> dimension_sizes, std::function<int(int)> rand) {
-  // Sort column_sets by number of remaining uncovered partial test cases. We
-  // sort the indices rather than the columns themselves.
-  std::vector<int64_t> column_set_index;
-  column_set_index.reserve(column_sets.size());
-  for (int i = 0; i < column_sets.size(); i++) column_set_index.push_back(i);
-  // Using stable_sort for consistency across systems.
-  std::ranges::stable_sort(column_set_index,
-                           [column_sets](int64_t idx1, int64_t idx2) {
-                             return column_sets[idx1].remaining_uncovered >
-                                    column_sets[idx2].remaining_uncovered;
-                           });
-
-  // If there is nothing left to cover, we are done!
-  if (column_sets[column_set_index[0]].remaining_uncovered == 0)
-    return std::nullopt;
+  int n = dimension_sizes.size();
+  const BitMask all_columns = (ONE << n) - 1;
 
   // `used` is the set of columns do we already have a value for.
   BitMask used_mask = 0;
 
-  int n = dimension_sizes.size();
   CoveringArrayTestCase result_test_case({.test_case = std::vector<int>(n)});
-  for (int i = 0; i < column_set_index.size(); i++) {
-    const ColumnSet& column_set = column_sets[column_set_index[i]];
+  for (int64_t idx : priority.MostUncoveredFirst()) {
+    const ColumnSet& column_set = column_sets[idx];
+    // The remaining column sets are all fully covered.
+    if (column_set.RemainingUncovered() == 0) break;
     if (used_mask & column_set.column_mask) continue;
-    if (column_set.remaining_uncovered == 0) continue;
 
     // Choose a random value that hasn't been seen before.
-    int64_t projected_value;
-    while (true) {
-      projected_value = rand(column_set.covered.size());
-      if (!column_set.covered[projected_value]) break;
-    }
+    SerializedTestCase projected_value;
+    do {
+      projected_value =
+          column_set.candidates[rand(column_set.candidates.size())];
+    } while (column_set.IsCovered(projected_value));
 
     DeserializePartialTestCaseInto(column_set.column_mask, projected_value,
                                    dimension_sizes, result_test_case);
     used_mask |= column_set.column_mask;
+    if (used_mask == all_columns) break;
   }
 
+  // If there is nothing left to cover, we are done!
+  if (used_mask == 0) return std::nullopt;
+
   // At this point, some fields may not be set still. Randomly assign those now.
   for (int i = 0; i < n; i++) {
     if (!((used_mask >> i) & ONE))
@@ -168,20 +227,27 @@ std::optional<CoveringArrayTestCase> FindTestCaseToAdd(
 }
 
 // Updates `column_set` to signify that `test_case` has been added to the set of
-// test cases.
-void UpdateColumnSet(const CoveringArrayTestCase& test_case,
+// test cases. Returns true if this covered a new partial test case.
+bool UpdateColumnSet(const CoveringArrayTestCase& test_case,
                      std::span<const int> dimension_sizes,
                      ColumnSet& column_set) {
   SerializedTestCase serial_test_case = SerializePartialTestCase(
       column_set.column_mask, test_case, dimension_sizes);
 
-  if (column_set.covered[serial_test_case]) return;  // Already covered.
-  column_set.covered[serial_test_case] = true;
+  if (column_set.IsCovered(serial_test_case)) return false;
+
+  column_set.covered[serial_test_case / 64] |= ONE << (serial_test_case % 64);
   column_set.remaining_uncovered--;
+  int64_t num_candidates = column_set.candidates.size();
+  if (num_candidates > 2 * column_set.remaining_uncovered) {
+    std::erase_if(column_set.candidates,
+                  [&](int32_t x) { return column_set.IsCovered(x); });
+  }
+  return true;
 }
 
-// Create all (n choose strength) column sets. Each set of columns will have its
-// `covered` array set to the appropriate number of values.
+// Create all (n choose strength) column sets. Each set of columns starts with
+// every partial test case uncovered.
 std::vector<ColumnSet> InitializeColumnSets(
     int n, int strength, std::span<const int> dimension_sizes) {
   std::vector<BitMask> masks = GetAllNChooseK(n, strength);
@@ -193,14 +259,177 @@ std::vector<ColumnSet> InitializeColumnSets(
     for (int i = 0; i < dimension_sizes.size(); i++)
       if ((mask >> i) & ONE) partial_test_case_size *= dimension_sizes[i];
 
-    column_sets.push_back(ColumnSet(
-        {.column_mask = mask,
-         .remaining_uncovered = partial_test_case_size,
-         .covered = std::vector<bool>(partial_test_case_size, false)}));
+    ABSL_CHECK_LE(partial_test_case_size,
+                  std::numeric_limits<int32_t>::max())
+        << "Too many partial test cases for a single set of columns.";
+
+    ColumnSet column_set = {.column_mask = mask,
+                            .remaining_uncovered = partial_test_case_size};
+    column_set.covered.assign((partial_test_case_size + 63) / 64, 0);
+    column_set.candidates.resize(partial_test_case_size);
+    std::iota(column_set.candidates.begin(), column_set.candidates.end(), 0);
+    column_sets.push_back(std::move(column_set));
   }
   return column_sets;
 }
 
+// -----------------------------------------------------------------------------
+//  In-parameter-order (IPOG) construction
+
+// A value in a partial test case that has not been chosen yet.
+constexpr int kDontCare = -1;
+
+// Returns all subsets of {0, 1, ... , n - 1} of size k, in lexicographic order,
+// concatenated into a single list.
+std::vector<int> GetAllSubsets(int n, int k) {
+  std::vector<int> subsets;
+  if (k > n) return subsets;
+  std::vector<int> subset(k);
+  std::iota(subset.begin(), subset.end(), 0);
+  while (true) {
+    subsets.insert(subsets.end(), subset.begin(), subset.end());
+    int i = k - 1;
+    while (i >= 0 && subset[i] == n - k + i) i--;
+    if (i < 0) break;
+    subset[i]++;
+    for (int j = i + 1; j < k; j++) subset[j] = subset[j - 1] + 1;
+  }
+  return subsets;
+}
+
+// The combinations of values that must be covered when adding a new column to
+// an IPOG covering array: for every subset of (strength - 1) earlier columns,
+// every combination of values in those columns and the new one.
+class NewColumnCoverage {
+ public:
+  NewColumnCoverage(std::span<const int> dimension_sizes, int new_column,
+                    int strength)
+      : dimension_sizes_(dimension_sizes),
+        new_column_size_(dimension_sizes[new_column]),
+        subset_size_(strength - 1),
+        subsets_(GetAllSubsets(new_column, strength - 1)) {
+    int64_t num_subsets =
+        subset_size_ == 0 ? 1 : subsets_.size() / subset_size_;
+    offsets_.reserve(num_subsets + 1);
+    offsets_.push_back(0);
+    for (int64_t s = 0; s < num_subsets; s++) {
+      int64_t size = new_column_size_;
+      for (int column : Subset(s)) size *= dimension_sizes_[column];
+      offsets_.push_back(offsets_.back() + size);
+    }
+    covered_.assign(offsets_.back(), false);
+  }
+
+  int64_t NumSubsets() const { return offsets_.size() - 1; }
+
+  std::span<const int> Subset(int64_t s) const {
+    return std::span<const int>(subsets_).subspan(s * subset_size_,
+                                                  subset_size_);
+  }
+
+  // Returns the index of `test_case`'s values in subset `s` (with value 0 in
+  // the new column), or nullopt if any of those values is kDontCare.
+  std::optional<int64_t> Index(int64_t s,
+                               std::span<const int> test_case) const {
+    int64_t index = 0;
+    for (int column : Subset(s)) {
+      if (test_case[column] == kDontCare) return std::nullopt;
+      index = index * dimension_sizes_[column] + test_case[column];
+    }
+    return offsets_[s] + index * new_column_size_;
+  }
+
+  // The entries for subset `s` are covered_[offsets_[s]...offsets_[s+1]-1].
+  std::vector<char>& Covered() { return covered_; }
+  int64_t Offset(int64_t s) const { return offsets_[s]; }
+
+ private:
+  std::span<const int> dimension_sizes_;
+  int new_column_size_;
+  int subset_size_;
+  std::vector<int> subsets_;
+  std::vector<int64_t> offsets_;
+  std::vector<char> covered_;
+};
+
+// Horizontal growth: sets the new column of every test case to the value that
+// covers the most new combinations. Ties are broken starting from a random
+// value. Test cases that would not cover anything new are left as kDontCare.
+void ExtendTestCases(int new_column, NewColumnCoverage& coverage,
+                     std::span<const int> dimension_sizes,
+                     std::vector<std::vector<int>>& test_cases,
+                     std::function<int(int)>& rand) {
+  int new_column_size = dimension_sizes[new_column];
+  std::vector<char>& covered = coverage.Covered();
+  std::vector<int64_t> indices;
+  std::vector<int64_t> gain(new_column_size);
+  for (std::vector<int>& test_case : test_cases) {
+    indices.clear();
+    for (int64_t s = 0; s < coverage.NumSubsets(); s++) {
+      if (std::optional<int64_t> index = coverage.Index(s, test_case))
+        indices.push_back(*index);
+    }
+
+    std::ranges::fill(gain, 0);
+    for (int64_t index : indices) {
+      for (int x = 0; x < new_column_size; x++) gain[x] += !covered[index + x];
+    }
+    int start = rand(new_column_size);
+    int best = start;
+    for (int i = 1; i < new_column_size; i++) {
+      int x = (start + i) % new_column_size;
+      if (gain[x] > gain[best]) best = x;
+    }
+    if (gain[best] == 0) continue;
+
+    test_case[new_column] = best;
+    for (int64_t index : indices) covered[index + best] = true;
+  }
+}
+
+// Vertical growth: covers each remaining combination by filling in kDontCare
+// values of a compatible test case, or by adding a new test case.
+void CoverRemaining(int new_column, NewColumnCoverage& coverage,
+                    std::span<const int> dimension_sizes,
+                    std::vector<std::vector<int>>& test_cases) {
+  int n = dimension_sizes.size();
+  std::vector<char>& covered = coverage.Covered();
+  std::vector<int> values;
+  for (int64_t s = 0; s < coverage.NumSubsets(); s++) {
+    std::span<const int> subset = coverage.Subset(s);
+    for (int64_t index = coverage.Offset(s); index < coverage.Offset(s + 1);
+         index++) {
+      if (covered[index]) continue;
+
+      // Decode the values in `subset` (then the new column) from `index`.
+      int64_t serialized = index - coverage.Offset(s);
+      values.assign(subset.size() + 1, 0);
+      values.back() = serialized % dimension_sizes[new_column];
+      serialized /= dimension_sizes[new_column];
+      for (int i = subset.size() - 1; i >= 0; i--) {
+        values[i] = serialized % dimension_sizes[subset[i]];
+        serialized /= dimension_sizes[subset[i]];
+      }
+
+      auto compatible = [&](const std::vector<int>& test_case) {
+        for (int i = 0; i < subset.size(); i++) {
+          int value = test_case[subset[i]];
+          if (value != kDontCare && value != values[i]) return false;
+        }
+        int value = test_case[new_column];
+        return value == kDontCare || value == values.back();
+      };
+      auto it = std::ranges::find_if(test_cases, compatible);
+      if (it == test_cases.end()) {
+        test_cases.push_back(std::vector<int>(n, kDontCare));
+        it = std::prev(test_cases.end());
+      }
+      for (int i = 0; i < subset.size(); i++) (*it)[subset[i]] = values[i];
+      (*it)[new_column] = values.back();
+    }
+  }
+}
+
 }  // namespace
 
 std::vector<CoveringArrayTestCase> GenerateCoveringArray(
@@ -220,18 +449,74 @@ std::vector<CoveringArrayTestCase> GenerateCoveringArray(
   std::vector<ColumnSet> column_sets =
       InitializeColumnSets(n, strength, dimension_sizes);
 
+  ColumnSetPriority priority(column_sets);
+
   std::vector<CoveringArrayTestCase> result;
   while (true) {
     std::optional<CoveringArrayTestCase> test_case =
-        FindTestCaseToAdd(column_sets, dimension_sizes, rand);
+        FindTestCaseToAdd(column_sets, priority, dimension_sizes, rand);
 
     if (test_case == std::nullopt) break;
 
     result.push_back(*test_case);
-    for (ColumnSet& column_set : column_sets)
-      UpdateColumnSet(*test_case, dimension_sizes, column_set);
+    for (int64_t i = 0; i < column_sets.size(); i++) {
+      if (UpdateColumnSet(*test_case, dimension_sizes, column_sets[i]))
+        priority.Decrement(i, column_sets[i].RemainingUncovered() + 1);
+    }
+  }
+
+  return result;
+}
+
+std::vector<CoveringArrayTestCase> GenerateCoveringArrayInParameterOrder(
+    std::vector<int> dimension_sizes, int strength,
+    std::function<int(int)> rand) {
+  ABSL_CHECK_GT(strength, 0) << "Strength must be > 0";
+  ABSL_CHECK_LE(strength, dimension_sizes.size())
+      << "Strength must be <= #dims";
+
+  for (int size : dimension_sizes) {
+    ABSL_CHECK_GT(size, 0) << "Dimension sizes must be > 0";
   }
 
+  // Adding the largest dimensions first keeps the array small.
+  int n = dimension_sizes.size();
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, [&](int a, int b) {
+    return dimension_sizes[a] > dimension_sizes[b];
+  });
+  std::vector<int> sizes(n);
+  for (int i = 0; i < n; i++) sizes[i] = dimension_sizes[order[i]];
+
+  // Every combination of values in the first `strength` columns.
+  std::vector<std::vector<int>> test_cases;
+  std::vector<int> test_case(n, kDontCare);
+  std::fill(test_case.begin(), test_case.begin() + strength, 0);
+  while (true) {
+    test_cases.push_back(test_case);
+    int i = strength - 1;
+    while (i >= 0 && test_case[i] == sizes[i] - 1) test_case[i--] = 0;
+    if (i < 0) break;
+    test_case[i]++;
+  }
+
+  for (int column = strength; column < n; column++) {
+    NewColumnCoverage coverage(sizes, column, strength);
+    ExtendTestCases(column, coverage, sizes, test_cases, rand);
+    CoverRemaining(column, coverage, sizes, test_cases);
+  }
+
+  std::vector<CoveringArrayTestCase> result;
+  result.reserve(test_cases.size());
+  for (const std::vector<int>& test_case : test_cases) {
+    CoveringArrayTestCase& tc =
+        result.emplace_back(std::vector<int>(n, kDontCare));
+    for (int i = 0; i < n; i++) {
+      tc.test_case[order[i]] =
+          test_case[i] == kDontCare ? rand(sizes[i]) : test_case[i];
+    }
+  }
   return result;
 }
 
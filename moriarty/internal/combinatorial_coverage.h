@@ -63,6 +63,23 @@ std::vector<CoveringArrayTestCase> GenerateCoveringArray(
     std::vector<int> dimension_sizes, int strength,
     std::function<int(int)> rand);
 
+// GenerateCoveringArrayInParameterOrder()
+//
+// Same as GenerateCoveringArray(), but built one dimension at a time using the
+// in-parameter-order (IPOG) strategy. We start with every combination of the
+// `strength` largest dimensions. Each new dimension is then added by:
+//   (1) extending each test case with the value that covers the most new
+//       combinations, then
+//   (2) adding test cases for the combinations that are still uncovered.
+//
+// The output is typically larger than GenerateCoveringArray()'s, but there is
+// no limit on the number of dimensions, and the work per dimension grows with
+// (#dims choose strength - 1) rather than (#dims choose strength). Strength 2
+// or 3 with 100+ dimensions takes seconds.
+std::vector<CoveringArrayTestCase> GenerateCoveringArrayInParameterOrder(
+    std::vector<int> dimension_sizes, int strength,
+    std::function<int(int)> rand);
+
 }  // namespace moriarty
 
 #endif  // MORIARTY_INTERNAL_COMBINATORIAL_COVERAGE_H_
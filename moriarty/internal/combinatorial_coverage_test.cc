@@ -14,6 +14,7 @@
 
 #include "moriarty/internal/combinatorial_coverage.h"
 
+#include <algorithm>
 #include <functional>
 #include <ostream>
 #include <vector>
@@ -61,5 +62,62 @@ TEST(CombinatorialCoverageTest, ProducesACoveringArray) {
               IsStrength2CoveringArray(std::vector<int>({3, 4, 1, 2})));
 }
 
+// Returns whether every combination of values in every 3 columns appears.
+bool IsStrength3CoveringArray(const std::vector<CoveringArrayTestCase>& array,
+                              const std::vector<int>& dimension_sizes) {
+  int n = dimension_sizes.size();
+  for (int i = 0; i < n; i++) {
+    for (int j = i + 1; j < n; j++) {
+      for (int k = j + 1; k < n; k++) {
+        int size_j = dimension_sizes[j];
+        int size_k = dimension_sizes[k];
+        std::vector<bool> seen(dimension_sizes[i] * size_j * size_k);
+        for (const CoveringArrayTestCase& tc : array) {
+          const std::vector<int>& v = tc.test_case;
+          seen[(v[i] * size_j + v[j]) * size_k + v[k]] = true;
+        }
+        if (std::ranges::find(seen, false) != seen.end()) return false;
+      }
+    }
+  }
+  return true;
+}
+
+TEST(CombinatorialCoverageTest, ProducesALargeStrength3CoveringArray) {
+  std::vector<int> dimension_sizes(20, 5);
+  std::vector<CoveringArrayTestCase> array =
+      GenerateCoveringArray(dimension_sizes, 3, RandFn());
+  EXPECT_TRUE(IsStrength3CoveringArray(array, dimension_sizes));
+}
+
+TEST(CombinatorialCoverageTest,
+     InParameterOrderWithFullStrengthShouldCoverEveryOption) {
+  EXPECT_THAT(GenerateCoveringArrayInParameterOrder({3, 3, 3}, 3, RandFn()),
+              SizeIs(27));
+  EXPECT_THAT(GenerateCoveringArrayInParameterOrder({2, 3, 4, 2}, 4, RandFn()),
+              SizeIs(48));
+}
+
+TEST(CombinatorialCoverageTest, InParameterOrderProducesACoveringArray) {
+  EXPECT_THAT(GenerateCoveringArrayInParameterOrder({3, 3, 3, 3}, 2, RandFn()),
+              IsStrength2CoveringArray(std::vector<int>({3, 3, 3, 3})));
+  EXPECT_THAT(GenerateCoveringArrayInParameterOrder({3, 4, 1, 2}, 2, RandFn()),
+              IsStrength2CoveringArray(std::vector<int>({3, 4, 1, 2})));
+  EXPECT_THAT(GenerateCoveringArrayInParameterOrder({2, 5, 3}, 1, RandFn()),
+              SizeIs(5));
+}
+
+TEST(CombinatorialCoverageTest, InParameterOrderShouldHandleManyDimensions) {
+  std::vector<int> pairwise_sizes(120, 4);
+  EXPECT_THAT(
+      GenerateCoveringArrayInParameterOrder(pairwise_sizes, 2, RandFn()),
+      IsStrength2CoveringArray(pairwise_sizes));
+
+  std::vector<int> threewise_sizes(100, 3);
+  EXPECT_TRUE(IsStrength3CoveringArray(
+      GenerateCoveringArrayInParameterOrder(threewise_sizes, 3, RandFn()),
+      threewise_sizes));
+}
+
 }  // namespace
 }  // namespace moriarty
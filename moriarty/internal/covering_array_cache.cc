@@ -0,0 +1,154 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/internal/covering_array_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "moriarty/internal/combinatorial_coverage.h"
+
+namespace moriarty {
+namespace moriarty_internal {
+
+namespace {
+
+// Bump the version in the magic string if the file format changes.
+constexpr std::string_view kMagic = "MCA1";
+
+// All integers are stored little-endian in `num_bytes` bytes.
+void AppendInteger(uint64_t value, int num_bytes, std::string& out) {
+  for (int i = 0; i < num_bytes; i++) out.push_back((value >> (8 * i)) & 0xFF);
+}
+
+std::optional<uint64_t> ConsumeInteger(int num_bytes, std::string_view& in) {
+  if (in.size() < num_bytes) return std::nullopt;
+  uint64_t value = 0;
+  for (int i = 0; i < num_bytes; i++) {
+    uint64_t byte = static_cast<unsigned char>(in[i]);
+    value |= byte << (8 * i);
+  }
+  in.remove_prefix(num_bytes);
+  return value;
+}
+
+// The header of the cache file. A file is only used if its header matches
+// exactly, so hash collisions are harmless.
+std::string SerializeKey(const CoveringArrayCacheKey& key) {
+  std::string out(kMagic);
+  AppendInteger(key.algorithm.size(), 4, out);
+  out += key.algorithm;
+  AppendInteger(key.strength, 4, out);
+  AppendInteger(key.seed, 8, out);
+  AppendInteger(key.dimension_sizes.size(), 4, out);
+  for (int size : key.dimension_sizes) AppendInteger(size, 4, out);
+  return out;
+}
+
+// 64-bit FNV-1a.
+uint64_t Fingerprint(std::string_view data) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+// The number of bytes needed to store any value in the array.
+int ValueWidth(std::span<const int> dimension_sizes) {
+  int max_size = dimension_sizes.empty()
+                     ? 0
+                     : *std::ranges::max_element(dimension_sizes);
+  if (max_size <= (1 << 8)) return 1;
+  if (max_size <= (1 << 16)) return 2;
+  return 4;
+}
+
+}  // namespace
+
+std::filesystem::path CoveringArrayCachePath(
+    const std::filesystem::path& directory, const CoveringArrayCacheKey& key) {
+  return directory /
+         std::format("{:016x}.covering_array", Fingerprint(SerializeKey(key)));
+}
+
+std::optional<std::vector<CoveringArrayTestCase>> ReadCachedCoveringArray(
+    const std::filesystem::path& directory, const CoveringArrayCacheKey& key) {
+  std::ifstream file(CoveringArrayCachePath(directory, key), std::ios::binary);
+  if (!file.is_open()) return std::nullopt;
+  std::string contents((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+
+  std::string_view in = contents;
+  std::string header = SerializeKey(key);
+  if (!in.starts_with(header)) return std::nullopt;
+  in.remove_prefix(header.size());
+
+  std::optional<uint64_t> num_rows = ConsumeInteger(8, in);
+  const int width = ValueWidth(key.dimension_sizes);
+  const int n = key.dimension_sizes.size();
+  if (!num_rows || in.size() != *num_rows * n * width) return std::nullopt;
+
+  std::vector<CoveringArrayTestCase> covering_array(*num_rows);
+  for (CoveringArrayTestCase& row : covering_array) {
+    row.test_case.resize(n);
+    for (int i = 0; i < n; i++) {
+      uint64_t value = *ConsumeInteger(width, in);
+      if (value >= key.dimension_sizes[i]) return std::nullopt;
+      row.test_case[i] = value;
+    }
+  }
+  return covering_array;
+}
+
+void WriteCachedCoveringArray(
+    const std::filesystem::path& directory, const CoveringArrayCacheKey& key,
+    std::span<const CoveringArrayTestCase> covering_array) {
+  std::string out = SerializeKey(key);
+  const int width = ValueWidth(key.dimension_sizes);
+  AppendInteger(covering_array.size(), 8, out);
+  for (const CoveringArrayTestCase& row : covering_array) {
+    for (int value : row.test_case) AppendInteger(value, width, out);
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) return;
+
+  // Write to a temporary file first so readers never see a partial entry.
+  std::filesystem::path path = CoveringArrayCachePath(directory, key);
+  std::filesystem::path tmp_path = path;
+  tmp_path += ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return;
+    file.write(out.data(), out.size());
+    if (!file) return;
+  }
+  std::filesystem::rename(tmp_path, path, ec);
+}
+
+}  // namespace moriarty_internal
+}  // namespace moriarty
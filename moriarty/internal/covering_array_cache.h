@@ -0,0 +1,71 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_INTERNAL_COVERING_ARRAY_CACHE_H_
+#define MORIARTY_INTERNAL_COVERING_ARRAY_CACHE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "moriarty/internal/combinatorial_coverage.h"
+
+namespace moriarty {
+namespace moriarty_internal {
+
+// CoveringArrayCacheKey
+//
+// Everything that determines the covering array that is built: the
+// construction used, its inputs, and the seed of its random stream.
+struct CoveringArrayCacheKey {
+  std::string algorithm;  // E.g., "greedy" or "ipog".
+  std::vector<int> dimension_sizes;
+  int strength;
+  int64_t seed;
+};
+
+// CoveringArrayCachePath()
+//
+// Returns the file in `directory` that holds the cache entry for `key`. The
+// filename is a hash of `key`.
+[[nodiscard]] std::filesystem::path CoveringArrayCachePath(
+    const std::filesystem::path& directory, const CoveringArrayCacheKey& key);
+
+// ReadCachedCoveringArray()
+//
+// Returns the covering array cached for `key` in `directory`, or std::nullopt
+// if there is none. A missing, corrupt or mismatched file is a cache miss, not
+// an error.
+[[nodiscard]] std::optional<std::vector<CoveringArrayTestCase>>
+ReadCachedCoveringArray(const std::filesystem::path& directory,
+                        const CoveringArrayCacheKey& key);
+
+// WriteCachedCoveringArray()
+//
+// Stores `covering_array` in `directory` (creating it if needed) as the cache
+// entry for `key`. The cache is only an optimization, so failures are ignored.
+//
+// Each entry is a small binary file: `key`, then every row, with each value
+// stored in 1, 2 or 4 bytes depending on the largest dimension size.
+void WriteCachedCoveringArray(
+    const std::filesystem::path& directory, const CoveringArrayCacheKey& key,
+    std::span<const CoveringArrayTestCase> covering_array);
+
+}  // namespace moriarty_internal
+}  // namespace moriarty
+
+#endif  // MORIARTY_INTERNAL_COVERING_ARRAY_CACHE_H_
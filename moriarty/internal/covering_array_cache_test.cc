@@ -0,0 +1,108 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/internal/covering_array_cache.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "moriarty/internal/combinatorial_coverage.h"
+
+namespace moriarty {
+namespace moriarty_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Field;
+using ::testing::Optional;
+
+std::filesystem::path CacheDirectory(std::string name) {
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  if (test_tmpdir == nullptr) ADD_FAILURE() << "TEST_TMPDIR is not set";
+  std::filesystem::path directory =
+      std::filesystem::path(test_tmpdir) / "covering_array_cache" / name;
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+CoveringArrayCacheKey Key() {
+  return {.algorithm = "ipog",
+          .dimension_sizes = {2, 3, 300},
+          .strength = 2,
+          .seed = 12345};
+}
+
+auto RowIs(std::vector<int> values) {
+  return Field(&CoveringArrayTestCase::test_case, Eq(values));
+}
+
+TEST(CoveringArrayCacheTest, WrittenArraysShouldBeReadBack) {
+  std::filesystem::path directory = CacheDirectory("ReadBack");
+  WriteCachedCoveringArray(directory, Key(),
+                           std::vector<CoveringArrayTestCase>(
+                               {{.test_case = {0, 2, 299}},
+                                {.test_case = {1, 0, 256}}}));
+
+  EXPECT_THAT(ReadCachedCoveringArray(directory, Key()),
+              Optional(ElementsAre(RowIs({0, 2, 299}), RowIs({1, 0, 256}))));
+}
+
+TEST(CoveringArrayCacheTest, EmptyDirectoryShouldMiss) {
+  EXPECT_EQ(ReadCachedCoveringArray(CacheDirectory("Empty"), Key()),
+            std::nullopt);
+}
+
+TEST(CoveringArrayCacheTest, DifferentKeysShouldMiss) {
+  std::filesystem::path directory = CacheDirectory("DifferentKeys");
+  WriteCachedCoveringArray(directory, Key(),
+                           std::vector<CoveringArrayTestCase>(
+                               {{.test_case = {0, 0, 0}}}));
+
+  for (auto change : {+[](CoveringArrayCacheKey& k) { k.seed++; },
+                      +[](CoveringArrayCacheKey& k) { k.strength++; },
+                      +[](CoveringArrayCacheKey& k) { k.algorithm = "x"; },
+                      +[](CoveringArrayCacheKey& k) {
+                        k.dimension_sizes.push_back(2);
+                      }}) {
+    CoveringArrayCacheKey key = Key();
+    change(key);
+    EXPECT_NE(CoveringArrayCachePath(directory, key),
+              CoveringArrayCachePath(directory, Key()));
+    EXPECT_EQ(ReadCachedCoveringArray(directory, key), std::nullopt);
+  }
+}
+
+TEST(CoveringArrayCacheTest, CorruptFilesShouldMiss) {
+  std::filesystem::path directory = CacheDirectory("Corrupt");
+  WriteCachedCoveringArray(directory, Key(),
+                           std::vector<CoveringArrayTestCase>(
+                               {{.test_case = {0, 0, 0}}}));
+  std::filesystem::path path = CoveringArrayCachePath(directory, Key());
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_EQ(ReadCachedCoveringArray(directory, Key()), std::nullopt);
+
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << "garbage";
+  EXPECT_EQ(ReadCachedCoveringArray(directory, Key()), std::nullopt);
+}
+
+}  // namespace
+}  // namespace moriarty_internal
+}  // namespace moriarty
@@ -130,6 +130,14 @@ ValueSet GenerateAllValues(VariableSet variables, ValueSet known_values,
                      generation_handler);
   }
 
+  if (options.stats != nullptr) {
+    const GenerationStats& stats = generation_handler.Stats();
+    options.stats->successful_generations += stats.successful_generations;
+    options.stats->failed_attempts += stats.failed_attempts;
+    options.stats->values_discarded += stats.values_discarded;
+    options.stats->values_kept += stats.values_kept;
+  }
+
   // We may have initially generated invalid values during the
   // AssignUniqueValues(). Let's check for those now...
   // TODO(darcybest): Determine if there's a better way of doing this...
@@ -19,6 +19,7 @@
 #include <span>
 #include <string>
 
+#include "moriarty/internal/generation_handler.h"
 #include "moriarty/internal/random_engine.h"
 #include "moriarty/internal/value_set.h"
 #include "moriarty/internal/variable_set.h"
@@ -33,6 +34,10 @@ struct GenerationOptions {
   // Only auto-generate values for these variables (and any variables they
   // depend on). If empty, all variables will be generated.
   std::span<const std::string> variables_to_generate;
+
+  // If set, statistics about this generation (e.g., how much work was wasted
+  // by failed attempts) are added to `*stats`.
+  GenerationStats* stats = nullptr;
 };
 
 // GenerateAllValues()
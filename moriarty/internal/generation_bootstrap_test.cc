@@ -28,6 +28,7 @@
 #include "gtest/gtest.h"
 #include "moriarty/constraints/equality_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/internal/generation_handler.h"
 #include "moriarty/internal/random_engine.h"
 #include "moriarty/internal/value_set.h"
 #include "moriarty/internal/variable_set.h"
@@ -116,6 +117,30 @@ TEST(GenerationBootstrapTest, GenerateAllValuesWithDependentVariablesSucceeds) {
   EXPECT_THAT(values.Get<MInteger>("A"), AllOf(Ge(N), Le(3 * N)));
 }
 
+TEST(GenerationBootstrapTest,
+     FailuresThatDoNotDependOnOtherVariablesShouldKeepTheirValues) {
+  RandomEngine rng({1, 2, 3}, "");
+  Context context =
+      Context()
+          .WithVariable("A", MInteger(Between(1, "N")).AddCustomConstraint(
+                                 "Multiple of 25",
+                                 [](int64_t a) { return a % 25 == 0; }))
+          .WithVariable("N", MInteger(Between(50, 100)));
+
+  GenerationStats stats;
+  ValueSet values = GenerateAllValues(context.Variables(), ValueSet(),
+                                      {.random_engine = rng, .stats = &stats});
+
+  int64_t N = values.Get<MInteger>("N");
+  EXPECT_THAT(N, AllOf(Ge(50), Le(100)));
+  EXPECT_THAT(values.Get<MInteger>("A"), AllOf(Ge(1), Le(N)));
+  EXPECT_EQ(values.Get<MInteger>("A") % 25, 0);
+
+  EXPECT_GE(stats.failed_attempts, 1);
+  EXPECT_GE(stats.values_kept, 1);
+  EXPECT_GE(stats.successful_generations, 2);  // A and N
+}
+
 TEST(GenerationBootstrapTest, GenerateAllValuesWithDependentValuesSucceeds) {
   RandomEngine rng({1, 2, 3}, "");
   Context context = Context()
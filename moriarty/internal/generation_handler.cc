@@ -14,16 +14,19 @@
 
 #include "moriarty/internal/generation_handler.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <format>
+#include <iterator>
 #include <optional>
-#include <stack>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
-#include "moriarty/librarian/errors.h"
+#include "moriarty/internal/range.h"
 #include "moriarty/librarian/policies.h"
 
 namespace moriarty {
@@ -37,94 +40,111 @@ GenerationHandler::GenerationHandler(int64_t max_active_retries,
       max_total_generate_calls_(max_total_generate_calls) {}
 
 void GenerationHandler::Start(std::string_view variable_name) {
-  auto it = generation_info_index_.find(variable_name);
-  if (it == generation_info_index_.end()) {
-    it = generation_info_index_
-             .emplace(std::string(variable_name), generation_info_.size())
-             .first;
-    generation_info_.push_back({.name = std::string(variable_name)});
+  for (const ActiveVariable& active : active_variables_) {
+    if (active.name == variable_name) {
+      throw std::runtime_error(
+          std::format("Cycle found in generation of {}", variable_name));
+    }
   }
-  int64_t idx = it->second;
 
-  GenerationInfo& info = generation_info_[idx];
-  if (info.variable_count_at_start.has_value()) {
-    throw std::runtime_error(
-        std::format("Cycle found in generation of {}", variable_name));
-  }
-
-  info.active_retry_count = 0;
-  info.variable_count_at_start = generated_variables_.size();
-
-  variables_actively_being_generated_.push(idx);
+  auto it = failures_.find(variable_name);
+  active_variables_.push_back(
+      {.name = std::string(variable_name),
+       .checkpoint = stored_values_.size(),
+       .failure_info = (it == failures_.end() ? nullptr : &it->second)});
 }
 
 void GenerationHandler::Complete() {
-  if (variables_actively_being_generated_.empty()) {
-    throw std::runtime_error(
-        "Attempting to complete generation, when none have been started.");
-  }
-
-  int idx = variables_actively_being_generated_.top();
-  variables_actively_being_generated_.pop();
-
-  generated_variables_.push_back(idx);
-  generation_info_[idx].active_retry_count = 0;
-  generation_info_[idx].variable_count_at_start = std::nullopt;
+  PopActiveVariable("complete");
   total_generate_calls_++;
+  stats_.successful_generations++;
 }
 
-void GenerationHandler::Abandon() {
-  if (variables_actively_being_generated_.empty()) {
-    throw std::runtime_error(
-        "Attempting to abandon generation, when none have been started.");
+void GenerationHandler::Abandon() { PopActiveVariable("abandon"); }
+
+void GenerationHandler::PopActiveVariable(std::string_view action) {
+  if (active_variables_.empty()) {
+    throw std::runtime_error(std::format(
+        "Attempting to {} generation, when none have been started.", action));
   }
+  active_variables_.pop_back();
+  // Nothing can be rolled back anymore.
+  if (active_variables_.empty()) stored_values_.clear();
+}
 
-  int idx = variables_actively_being_generated_.top();
-  variables_actively_being_generated_.pop();
-  generation_info_[idx].active_retry_count = 0;
-  generation_info_[idx].variable_count_at_start = std::nullopt;
+void GenerationHandler::MarkValueStored(std::string_view variable_name) {
+  if (active_variables_.empty()) return;
+  stored_values_.push_back(std::string(variable_name));
 }
 
 RetryRecommendation GenerationHandler::ReportFailure(
-    std::string failure_reason) {
-  if (variables_actively_being_generated_.empty()) {
+    std::string failure_reason,
+    std::optional<std::span<const std::string>> culprits) {
+  if (active_variables_.empty()) {
     throw std::runtime_error(
         "Attempting to report a failure in generation, when none have been "
         "started.");
   }
 
-  int idx = variables_actively_being_generated_.top();
-  GenerationInfo& info = generation_info_[idx];
-  info.active_retry_count++;
+  ActiveVariable& active = active_variables_.back();
+  if (active.failure_info == nullptr)
+    active.failure_info = &failures_[active.name];
+  FailureInfo& info = *active.failure_info;
+  active.active_retry_count++;
   info.total_retry_count++;
   info.most_recent_failure = std::move(failure_reason);
 
   total_generate_calls_++;
-
-  std::vector<std::string> variables_to_delete;
-  for (int64_t i = *info.variable_count_at_start;
-       i < generated_variables_.size(); ++i) {
-    variables_to_delete.push_back(
-        generation_info_[generated_variables_[i]].name);
+  stats_.failed_attempts++;
+
+  size_t rollback_to = active.checkpoint;
+  if (culprits && active.active_retry_count % kFullRollbackInterval != 0) {
+    rollback_to = stored_values_.size();
+    for (size_t i = active.checkpoint; i < stored_values_.size(); i++) {
+      if (std::ranges::find(*culprits, stored_values_[i]) != culprits->end()) {
+        rollback_to = i;
+        break;
+      }
+    }
   }
-  generated_variables_.resize(*info.variable_count_at_start);
+  stats_.values_kept += rollback_to - active.checkpoint;
+  stats_.values_discarded += stored_values_.size() - rollback_to;
+
+  std::vector<std::string> variables_to_delete(
+      std::make_move_iterator(stored_values_.begin() + rollback_to),
+      std::make_move_iterator(stored_values_.end()));
+  stored_values_.resize(rollback_to);
+  if (!variables_to_delete.empty()) integer_extremes_cache_.clear();
 
-  auto should_retry = (info.active_retry_count > max_active_retries_ ||
+  auto should_retry = (active.active_retry_count > max_active_retries_ ||
                        info.total_retry_count > max_total_retries_ ||
                        total_generate_calls_ > max_total_generate_calls_)
                           ? RetryPolicy::kAbort
                           : RetryPolicy::kRetry;
 
-  return {should_retry, variables_to_delete};
+  return {should_retry, std::move(variables_to_delete)};
 }
 
 std::optional<std::string> GenerationHandler::GetFailureReason(
     std::string_view variable_name) const {
-  auto it = generation_info_index_.find(variable_name);
-  if (it == generation_info_index_.end()) throw VariableNotFound(variable_name);
+  auto it = failures_.find(variable_name);
+  if (it == failures_.end()) return std::nullopt;
+  return it->second.most_recent_failure;
+}
+
+std::optional<Range::ExtremeValues<int64_t>>
+GenerationHandler::GetCachedIntegerExtremes(const Range& range) const {
+  auto it = integer_extremes_cache_.find(range.CacheKey());
+  if (it == integer_extremes_cache_.end()) return std::nullopt;
+  return it->second;
+}
 
-  return generation_info_[it->second].most_recent_failure;
+void GenerationHandler::CacheIntegerExtremes(
+    const Range& range, Range::ExtremeValues<int64_t> extremes) {
+  integer_extremes_cache_.insert_or_assign(range.CacheKey(), extremes);
 }
 
+const GenerationStats& GenerationHandler::Stats() const { return stats_; }
+
 }  // namespace moriarty_internal
 }  // namespace moriarty
@@ -15,15 +15,17 @@
 #ifndef MORIARTY_INTERNAL_GENERATION_HANDLER_H_
 #define MORIARTY_INTERNAL_GENERATION_HANDLER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <optional>
-#include <stack>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
+#include "moriarty/internal/range.h"
 #include "moriarty/librarian/policies.h"
 #include "moriarty/librarian/util/str_hash.h"
 
@@ -42,11 +44,32 @@ struct RetryRecommendation {
   std::vector<std::string> variable_names_to_delete;
 };
 
+// GenerationStats
+//
+// Statistics about how much work was wasted by failed generation attempts.
+struct GenerationStats {
+  // Number of variables that were generated successfully.
+  int64_t successful_generations = 0;
+  // Number of generation attempts that failed (and were possibly retried).
+  int64_t failed_attempts = 0;
+  // Number of stored values that were deleted because of a failure, and will
+  // need to be generated again.
+  int64_t values_discarded = 0;
+  // Number of stored values that a full rollback would have deleted, but were
+  // kept since they did not feed the failure.
+  int64_t values_kept = 0;
+};
+
 // GenerationHandler()
 //
 // Maintains the list of variables that are being generated. As you
 // generate variables, it must be in a stack-based order (the stack comes from
 // dependent variables and subvariables).
+//
+// Bookkeeping is proportional to the depth of the stack plus the number of
+// variables that have failed (and values stored while a variable is active),
+// not the number of variables generated. In particular, the elements of a
+// large array do not leave anything behind once they are complete.
 class GenerationHandler {
  public:
   constexpr static int64_t kDefaultMaxActiveRetries = 1000;
@@ -84,51 +107,108 @@ class GenerationHandler {
   // again. (Think: stack order)
   void Abandon();
 
+  // MarkValueStored()
+  //
+  // Informs that a value for `variable_name` has been stored. If any variable
+  // that is currently active later fails, `variable_name` will be in its list
+  // of variables to delete. If no variable is active, this is a no-op.
+  void MarkValueStored(std::string_view variable_name);
+
   // ReportFailure()
   //
   // Informs that the active variable has failed to generate a value.
   // This function returns a recommendation for if the variable should retry
   // generation or abort generation.
   //
-  // The list of variables to be deleted in the recommendation are those that
-  // were generated since this variable started its generation. The caller
-  // should delete those variables.
+  // The list of variables to be deleted in the recommendation are those whose
+  // values were stored (via MarkValueStored()) since this variable started its
+  // generation. The caller should delete those variables.
+  //
+  // If `culprits` is set, the failure was caused only by the values of the
+  // variables in `culprits` (e.g., the dependencies of the constraint that was
+  // not satisfied). Then only the values stored since the first culprit was
+  // stored are deleted (later values may depend on it); everything stored
+  // before that is kept. Every `kFullRollbackInterval`-th failure in a row
+  // still deletes everything, in case the kept values make this variable
+  // impossible to generate.
   //
   // The active variable is not updated.
-  [[nodiscard]] RetryRecommendation ReportFailure(std::string failure_reason);
+  [[nodiscard]] RetryRecommendation ReportFailure(
+      std::string failure_reason,
+      std::optional<std::span<const std::string>> culprits = std::nullopt);
 
   // GetFailureReason()
   //
-  // Returns the most recent failure reason for `variable_name`, if there is
-  // one.
+  // Returns the most recent failure reason for `variable_name`, if it has ever
+  // failed.
   [[nodiscard]] std::optional<std::string> GetFailureReason(
       std::string_view variable_name) const;
 
+  // GetCachedIntegerExtremes()
+  //
+  // Returns the extremes of `range` recorded via CacheIntegerExtremes(), unless
+  // some stored value has been deleted (by a failure) since then.
+  [[nodiscard]] std::optional<Range::ExtremeValues<int64_t>>
+  GetCachedIntegerExtremes(const Range& range) const;
+
+  // CacheIntegerExtremes()
+  //
+  // Records the extremes of `range`, which must have been computed from the
+  // values that are currently stored.
+  void CacheIntegerExtremes(const Range& range,
+                            Range::ExtremeValues<int64_t> extremes);
+
+  // Stats()
+  //
+  // Returns statistics about all generation so far.
+  [[nodiscard]] const GenerationStats& Stats() const;
+
+  // After this many failures in a row of the same variable, ReportFailure()
+  // deletes everything stored since the variable started, even if it was given
+  // culprits.
+  constexpr static int64_t kFullRollbackInterval = 10;
+
  private:
   int64_t max_active_retries_;
   int64_t max_total_retries_;
   int64_t max_total_generate_calls_;
   int64_t total_generate_calls_ = 0;
+  GenerationStats stats_;
 
-  // Retry counts.
-  //  * "Active" is set to 0 whenever Complete() or Abandon() is called.
-  //  * "Total" is never reset.
-  struct GenerationInfo {
-    std::string name;
+  // Only variables that have failed at least once have a record. The total
+  // retry count is never reset.
+  struct FailureInfo {
     int64_t total_retry_count = 0;
+    std::string most_recent_failure;
+  };
+  std::unordered_map<std::string, FailureInfo, StrHash, std::equal_to<>>
+      failures_;
+
+  // A variable that is actively being generated. The "active" retry count only
+  // lives as long as the frame does.
+  struct ActiveVariable {
+    std::string name;
     int64_t active_retry_count = 0;
-    std::optional<std::string> most_recent_failure;
-    std::optional<int64_t> variable_count_at_start;
+    // The size of `stored_values_` when this variable started. On failure, we
+    // roll back to this point.
+    size_t checkpoint;
+    // Points into `failures_` once this variable has failed.
+    FailureInfo* failure_info = nullptr;
   };
-  std::vector<GenerationInfo> generation_info_;
+  std::vector<ActiveVariable> active_variables_;
+
+  // Variables whose values were stored while some variable was active, in the
+  // order they were stored. Cleared whenever the stack becomes empty.
+  std::vector<std::string> stored_values_;
 
-  // These variables represent the index in `generation_info_`.
+  // Resolved extremes of ranges, keyed by `Range::CacheKey()`. The values they
+  // were computed from only change when stored values are deleted, so this is
+  // cleared whenever that happens.
+  std::unordered_map<uint64_t, Range::ExtremeValues<int64_t>>
+      integer_extremes_cache_;
 
-  // variables that were generated, in the order they were generated.
-  std::unordered_map<std::string, int64_t, StrHash, std::equal_to<>>
-      generation_info_index_;
-  std::vector<int64_t> generated_variables_;
-  std::stack<int64_t> variables_actively_being_generated_;
+  // Pops the active variable. Throws if there is none.
+  void PopActiveVariable(std::string_view action);
 };
 
 }  // namespace moriarty_internal
@@ -15,14 +15,16 @@
 
 #include "moriarty/internal/generation_handler.h"
 
+#include <cstdint>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "moriarty/internal/range.h"
 #include "moriarty/librarian/policies.h"
-#include "moriarty/librarian/testing/gtest_helpers.h"
 
 namespace moriarty {
 namespace moriarty_internal {
@@ -31,7 +33,6 @@ namespace {
 using RetryPolicy::kAbort;
 using RetryPolicy::kRetry;
 
-using moriarty_testing::ThrowsVariableNotFound;
 using testing::ElementsAre;
 using testing::Eq;
 using testing::FieldsAre;
@@ -99,6 +100,7 @@ TEST(GenerationHandlerTest, GenerationAttemptForMultipleVariablesShouldWork) {
     h.Start("y");
     EXPECT_THAT(h.ReportFailure("y1"), FieldsAre(kRetry, IsEmpty()));
     h.Complete();
+    h.MarkValueStored("y");
     EXPECT_THAT(h.ReportFailure("x2"), FieldsAre(kRetry, ElementsAre("y")));
     EXPECT_THAT(h.ReportFailure("x3"), FieldsAre(kAbort, IsEmpty()));
   }
@@ -164,10 +166,9 @@ TEST(GenerationHandlerTest, TotalGenerationCallsShouldStopGeneration) {
 }
 
 TEST(GenerationHandlerTest, GetFailureReasonShouldWork) {
-  {  // Not found
+  {  // Never started
     GenerationHandler h;
-    EXPECT_THAT([&] { (void)h.GetFailureReason("x"); },
-                ThrowsVariableNotFound("x"));
+    EXPECT_EQ(h.GetFailureReason("x"), std::nullopt);
   }
   {  // Before adding message
     GenerationHandler h;
@@ -246,7 +247,9 @@ TEST(GenerationHandlerTest,
   h.Start("y");
   h.Start("z");
   h.Complete();
+  h.MarkValueStored("z");
   h.Complete();
+  h.MarkValueStored("y");
   EXPECT_THAT(h.ReportFailure("xfail"),
               FieldsAre(kRetry, UnorderedElementsAre("y", "z")));
 }
@@ -256,22 +259,123 @@ TEST(GenerationHandlerTest,
   GenerationHandler h;
   h.Start("w");
   h.Complete();
+  h.MarkValueStored("w");
 
   h.Start("x");
   h.Start("y");
   h.Start("z");
   h.Complete();
+  h.MarkValueStored("z");
   h.Complete();
+  h.MarkValueStored("y");
   EXPECT_THAT(h.ReportFailure("xfail"),
               FieldsAre(kRetry, UnorderedElementsAre("y", "z")));
   h.Start("p");
   h.Start("q");
   h.Complete();
+  h.MarkValueStored("q");
   h.Complete();
+  h.MarkValueStored("p");
   EXPECT_THAT(h.ReportFailure("xfail"),
               FieldsAre(kRetry, UnorderedElementsAre("p", "q")));
 }
 
+TEST(GenerationHandlerTest, VariablesWithoutStoredValuesAreNotDeleted) {
+  GenerationHandler h;
+  h.Start("A");
+  for (int i = 0; i < 1000; i++) {
+    h.Start("A[i]");
+    h.Complete();
+  }
+  h.Start("N");
+  h.Complete();
+  h.MarkValueStored("N");
+  EXPECT_THAT(h.ReportFailure("Afail"), FieldsAre(kRetry, ElementsAre("N")));
+  EXPECT_THAT(h.ReportFailure("Afail"), FieldsAre(kRetry, IsEmpty()));
+}
+
+TEST(GenerationHandlerTest, StoredValuesAreForgottenOnceNothingIsActive) {
+  GenerationHandler h;
+  h.MarkValueStored("w");
+  h.Start("x");
+  h.MarkValueStored("y");
+  h.Complete();
+
+  h.Start("z");
+  EXPECT_THAT(h.ReportFailure("zfail"), FieldsAre(kRetry, IsEmpty()));
+}
+
+TEST(GenerationHandlerTest,
+     CulpritsShouldOnlyDeleteValuesFromTheFirstCulprit) {
+  GenerationHandler h;
+  h.Start("x");
+  h.MarkValueStored("a");
+  h.MarkValueStored("b");
+  h.MarkValueStored("c");
+
+  std::vector<std::string> culprits = {"b"};
+  EXPECT_THAT(h.ReportFailure("xfail", culprits),
+              FieldsAre(kRetry, ElementsAre("b", "c")));
+  EXPECT_THAT(h.ReportFailure("xfail", std::vector<std::string>{}),
+              FieldsAre(kRetry, IsEmpty()));
+  EXPECT_THAT(h.ReportFailure("xfail"), FieldsAre(kRetry, ElementsAre("a")));
+}
+
+TEST(GenerationHandlerTest,
+     RepeatedFailuresWithCulpritsShouldDeleteEverything) {
+  GenerationHandler h;
+  h.Start("x");
+  h.MarkValueStored("a");
+
+  std::vector<std::string> no_culprits;
+  for (int i = 1; i < GenerationHandler::kFullRollbackInterval; i++) {
+    EXPECT_THAT(h.ReportFailure("xfail", no_culprits),
+                FieldsAre(kRetry, IsEmpty()));
+  }
+  EXPECT_THAT(h.ReportFailure("xfail", no_culprits),
+              FieldsAre(kRetry, ElementsAre("a")));
+}
+
+TEST(GenerationHandlerTest, StatsShouldCountWastedWork) {
+  GenerationHandler h;
+  h.Start("x");
+  h.MarkValueStored("a");
+  h.MarkValueStored("b");
+  (void)h.ReportFailure("xfail", std::vector<std::string>{"b"});
+  (void)h.ReportFailure("xfail");
+  h.Complete();
+
+  EXPECT_EQ(h.Stats().successful_generations, 1);
+  EXPECT_EQ(h.Stats().failed_attempts, 2);
+  EXPECT_EQ(h.Stats().values_discarded, 2);  // b, then a
+  EXPECT_EQ(h.Stats().values_kept, 1);       // a
+}
+
+TEST(GenerationHandlerTest, CachedExtremesShouldBeReturned) {
+  GenerationHandler h;
+  Range r = Range().AtLeast(1).AtMost(Expression("N"));
+  EXPECT_EQ(h.GetCachedIntegerExtremes(r), std::nullopt);
+
+  h.CacheIntegerExtremes(r, {1, 5});
+  EXPECT_THAT(h.GetCachedIntegerExtremes(r),
+              Optional(Range::ExtremeValues<int64_t>({1, 5})));
+  EXPECT_EQ(h.GetCachedIntegerExtremes(Range(r).AtMost(3)), std::nullopt);
+}
+
+TEST(GenerationHandlerTest, CachedExtremesShouldBeClearedWhenValuesAreDeleted) {
+  GenerationHandler h;
+  Range r = Range().AtLeast(1).AtMost(Expression("N"));
+
+  h.Start("x");
+  h.CacheIntegerExtremes(r, {1, 5});
+  EXPECT_THAT(h.ReportFailure("xfail"), FieldsAre(kRetry, IsEmpty()));
+  EXPECT_NE(h.GetCachedIntegerExtremes(r), std::nullopt);
+
+  h.MarkValueStored("N");
+  EXPECT_THAT(h.ReportFailure("xfail"), FieldsAre(kRetry, ElementsAre("N")));
+  EXPECT_EQ(h.GetCachedIntegerExtremes(r), std::nullopt);
+}
+
 }  // namespace
 }  // namespace moriarty_internal
 }  // namespace moriarty
@@ -0,0 +1,77 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/internal/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace moriarty {
+namespace moriarty_internal {
+
+int ResolveNumThreads(int num_threads) {
+  if (num_threads > 0) return num_threads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ParallelFor(int64_t n, int num_threads,
+                 const std::function<void(int64_t)>& fn) {
+  num_threads = std::min<int64_t>(ResolveNumThreads(num_threads), n);
+  if (num_threads <= 1) {
+    for (int64_t i = 0; i < n; i++) fn(i);
+    return;
+  }
+
+  std::atomic<int64_t> next_index = 0;
+  std::atomic<bool> failed = false;
+  std::mutex mutex;
+  int64_t first_failed_index = std::numeric_limits<int64_t>::max();
+  std::exception_ptr first_exception;
+
+  auto worker = [&] {
+    while (!failed.load(std::memory_order_relaxed)) {
+      int64_t i = next_index.fetch_add(1);
+      if (i >= n) return;
+      try {
+        fn(i);
+      } catch (...) {
+        std::lock_guard lock(mutex);
+        if (i < first_failed_index) {
+          first_failed_index = i;
+          first_exception = std::current_exception();
+        }
+        failed = true;
+      }
+    }
+  };
+
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(num_threads - 1);
+    for (int t = 1; t < num_threads; t++) threads.emplace_back(worker);
+    worker();
+  }  // Joins all threads.
+
+  if (first_exception) std::rethrow_exception(first_exception);
+}
+
+}  // namespace moriarty_internal
+}  // namespace moriarty
@@ -0,0 +1,47 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_INTERNAL_PARALLEL_H_
+#define MORIARTY_INTERNAL_PARALLEL_H_
+
+#include <cstdint>
+#include <functional>
+
+namespace moriarty {
+namespace moriarty_internal {
+
+// ResolveNumThreads()
+//
+// Returns `num_threads` if it is positive, otherwise the number of hardware
+// threads available (at least 1).
+[[nodiscard]] int ResolveNumThreads(int num_threads);
+
+// ParallelFor()
+//
+// Calls `fn(i)` for each i in [0, n), using up to `num_threads` threads (see
+// ResolveNumThreads()). The calling thread is one of them, so with
+// `num_threads == 1` everything runs in order on the calling thread. Indices
+// are started in increasing order, but may finish in any order.
+//
+// If any call throws, no new indices are started, and once all running calls
+// finish, the exception from the smallest failing index is rethrown. Since
+// indices are started in order, this is the same exception a sequential loop
+// would throw.
+void ParallelFor(int64_t n, int num_threads,
+                 const std::function<void(int64_t)>& fn);
+
+}  // namespace moriarty_internal
+}  // namespace moriarty
+
+#endif  // MORIARTY_INTERNAL_PARALLEL_H_
@@ -0,0 +1,76 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/internal/parallel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace moriarty {
+namespace moriarty_internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::IsEmpty;
+using ::testing::ThrowsMessage;
+
+TEST(ParallelTest, ResolveNumThreadsShouldRespectPositiveValues) {
+  EXPECT_EQ(ResolveNumThreads(3), 3);
+  EXPECT_THAT(ResolveNumThreads(0), Ge(1));
+  EXPECT_THAT(ResolveNumThreads(-1), Ge(1));
+}
+
+TEST(ParallelTest, ParallelForShouldCallEachIndexOnce) {
+  for (int num_threads : {0, 1, 2, 8}) {
+    std::vector<std::atomic<int>> calls(1000);
+    ParallelFor(calls.size(), num_threads, [&](int64_t i) { calls[i]++; });
+    for (const auto& c : calls) EXPECT_EQ(c.load(), 1);
+  }
+}
+
+TEST(ParallelTest, ParallelForWithOneThreadShouldRunInOrder) {
+  std::vector<int64_t> order;
+  ParallelFor(5, 1, [&](int64_t i) { order.push_back(i); });
+  EXPECT_THAT(order, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ParallelTest, ParallelForWithNoWorkShouldDoNothing) {
+  std::vector<int64_t> order;
+  ParallelFor(0, 4, [&](int64_t i) { order.push_back(i); });
+  EXPECT_THAT(order, IsEmpty());
+}
+
+TEST(ParallelTest, ParallelForShouldRethrowTheSmallestFailingIndex) {
+  for (int num_threads : {1, 2, 8}) {
+    EXPECT_THAT(
+        [&] {
+          ParallelFor(1000, num_threads, [](int64_t i) {
+            if (i % 100 == 37) throw std::runtime_error(std::to_string(i));
+          });
+        },
+        ThrowsMessage<std::runtime_error>(Eq("37")));
+  }
+}
+
+}  // namespace
+}  // namespace moriarty_internal
+}  // namespace moriarty
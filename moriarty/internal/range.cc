@@ -15,6 +15,7 @@
 #include "moriarty/internal/range.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <format>
 #include <functional>
@@ -34,31 +35,37 @@
 namespace moriarty {
 
 Range& Range::AtLeast(int64_t minimum) {
+  cache_key_ = NewCacheKey();
   min_int_ = std::max(min_int_, minimum);
   return *this;
 }
 
 Range& Range::AtLeast(Expression minimum) {
+  cache_key_ = NewCacheKey();
   min_exprs_.push_back(std::move(minimum));
   return *this;
 }
 
 Range& Range::AtLeast(const Real& minimum) {
+  cache_key_ = NewCacheKey();
   min_real_ = min_real_ ? std::max(*min_real_, minimum) : minimum;
   return *this;
 }
 
 Range& Range::AtMost(int64_t maximum) {
+  cache_key_ = NewCacheKey();
   max_int_ = std::min(max_int_, maximum);
   return *this;
 }
 
 Range& Range::AtMost(Expression maximum) {
+  cache_key_ = NewCacheKey();
   max_exprs_.push_back(std::move(maximum));
   return *this;
 }
 
 Range& Range::AtMost(const Real& maximum) {
+  cache_key_ = NewCacheKey();
   max_real_ = max_real_ ? std::min(*max_real_, maximum) : maximum;
   return *this;
 }
@@ -110,7 +117,60 @@ std::optional<Range::ExtremeValues<Real>> Range::RealExtremes(
   return real_extremes;
 }
 
+namespace {
+
+// The values of the variables needed to evaluate some expressions.
+using KnownValues = std::vector<std::pair<std::string, int64_t>>;
+
+// Looks up the value of every variable that `exprs` depend on, appending them
+// to `known`. Returns false if any of them is not known.
+bool LookupDependencies(
+    std::span<const Expression> exprs,
+    const std::function<std::optional<int64_t>(std::string_view)>& get_value,
+    KnownValues& known) {
+  for (const Expression& expr : exprs) {
+    for (const std::string& var : expr.GetDependencies()) {
+      std::optional<int64_t> value = get_value(var);
+      if (!value) return false;
+      known.emplace_back(var, *value);
+    }
+  }
+  return true;
+}
+
+// Returns a lookup function for values that are all already known.
+std::function<int64_t(std::string_view)> KnownValueLookup(
+    const KnownValues& known) {
+  return [&known](std::string_view var) {
+    return std::ranges::find(known, var, &KnownValues::value_type::first)
+        ->second;
+  };
+}
+
+}  // namespace
+
+std::optional<Range::ExtremeValues<int64_t>> Range::IntegerExtremesIfKnown(
+    std::function<std::optional<int64_t>(std::string_view)> get_value) const {
+  KnownValues known;
+  if (!LookupDependencies(min_exprs_, get_value, known) ||
+      !LookupDependencies(max_exprs_, get_value, known)) {
+    return std::nullopt;
+  }
+  return IntegerExtremes(KnownValueLookup(known));
+}
+
+std::optional<Range::ExtremeValues<Real>> Range::RealExtremesIfKnown(
+    std::function<std::optional<int64_t>(std::string_view)> get_value) const {
+  KnownValues known;
+  if (!LookupDependencies(min_exprs_, get_value, known) ||
+      !LookupDependencies(max_exprs_, get_value, known)) {
+    return std::nullopt;
+  }
+  return RealExtremes(KnownValueLookup(known));
+}
+
 void Range::Intersect(const Range& other) {
+  cache_key_ = NewCacheKey();
   AtLeast(other.min_int_);
   AtMost(other.max_int_);
   if (other.min_real_) AtLeast(*other.min_real_);
@@ -186,6 +246,11 @@ bool operator==(const Range& r1, const Range& r2) {
   return true;
 }
 
+uint64_t Range::NewCacheKey() {
+  static std::atomic<uint64_t> next_key = 0;
+  return next_key.fetch_add(1, std::memory_order_relaxed);
+}
+
 Range EmptyRange() { return Range().AtLeast(1).AtMost(0); }
 
 }  // namespace moriarty
@@ -88,12 +88,31 @@ class Range {
   std::optional<ExtremeValues<Real>> RealExtremes(
       std::function<int64_t(std::string_view)> get_value) const;
 
+  // IntegerExtremesIfKnown()
+  // RealExtremesIfKnown()
+  //
+  // Same as IntegerExtremes() and RealExtremes(), but `get_value(var_name)` may
+  // return `std::nullopt` if the value of that variable is not known (yet).
+  // Returns `std::nullopt` if the range is empty or if any needed variable is
+  // not known.
+  std::optional<ExtremeValues<int64_t>> IntegerExtremesIfKnown(
+      std::function<std::optional<int64_t>(std::string_view)> get_value) const;
+  std::optional<ExtremeValues<Real>> RealExtremesIfKnown(
+      std::function<std::optional<int64_t>(std::string_view)> get_value) const;
+
   // Intersect()
   //
   // Intersects `other` with this Range (updating this range with the
   // intersection).
   void Intersect(const Range& other);
 
+  // CacheKey()
+  //
+  // Returns a key identifying the contents of this range. Copies of a range
+  // share its key and any modification gives the range a new key, so two
+  // ranges with the same key are always equal (but not vice versa).
+  [[nodiscard]] uint64_t CacheKey() const { return cache_key_; }
+
   // ToString()
   //
   // Returns a string representation of this range.
@@ -117,6 +136,9 @@ class Range {
   // order to determine which is largest/smallest.
   std::vector<Expression> min_exprs_;
   std::vector<Expression> max_exprs_;
+
+  uint64_t cache_key_ = NewCacheKey();
+  static uint64_t NewCacheKey();
 };
 
 // Creates a range with no elements in it.
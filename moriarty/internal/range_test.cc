@@ -228,6 +228,44 @@ TEST(RangeTest, ExpressionsWorkInAtLeastAndAtMost) {
   EXPECT_EQ(R.IntegerExtremes(FromMap({{"N", 0}})), std::nullopt);
 }
 
+TEST(RangeTest, ExtremesIfKnownShouldReturnNulloptForUnknownVariables) {
+  Range R;
+  R.AtLeast(Expression("N + 5"));
+  R.AtMost(Expression("3 * M + 1"));
+
+  auto known = [](std::string_view var) -> std::optional<int64_t> {
+    if (var == "N") return 4;
+    return std::nullopt;
+  };
+  auto all_known = [](std::string_view var) -> std::optional<int64_t> {
+    return 4;
+  };
+
+  EXPECT_EQ(R.IntegerExtremesIfKnown(known), std::nullopt);
+  EXPECT_EQ(R.RealExtremesIfKnown(known), std::nullopt);
+  EXPECT_THAT(R.IntegerExtremesIfKnown(all_known),
+              Optional(Range::ExtremeValues<int64_t>({9, 13})));
+  EXPECT_THAT(R.RealExtremesIfKnown(all_known),
+              Optional(Range::ExtremeValues<Real>({Real(9), Real(13)})));
+  EXPECT_EQ(EmptyRange().IntegerExtremesIfKnown(known), std::nullopt);
+}
+
+TEST(RangeTest, CacheKeyShouldChangeOnlyWhenTheRangeChanges) {
+  Range r1 = NewRange(1, 10);
+  Range r2 = r1;
+  EXPECT_EQ(r1.CacheKey(), r2.CacheKey());
+  EXPECT_NE(r1.CacheKey(), NewRange(1, 10).CacheKey());
+
+  uint64_t key = r2.CacheKey();
+  r2.AtMost(Expression("N"));
+  EXPECT_NE(r2.CacheKey(), key);
+  EXPECT_EQ(r1.CacheKey(), key);
+
+  key = r1.CacheKey();
+  r1.Intersect(NewRange(3, 5));
+  EXPECT_NE(r1.CacheKey(), key);
+}
+
 TEST(RangeTest, RealsWorkInAtLeastAndAtMost) {
   EXPECT_EQ(
       Range().AtLeast(Real(5, 2)).AtMost(Real(0)).RealExtremes(FromMap({})),
@@ -19,12 +19,17 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <format>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -405,41 +410,167 @@ PatternNode ParseScopePrefix(std::string_view pattern) {
   return anyof_node;
 }
 
-std::optional<int64_t> MatchesPrefixLength(const PatternNode& pattern_node,
-                                           std::string_view str,
+CompiledSimplePattern::CompiledSimplePattern(
+    const PatternNode& root, const Expression::LookupFn& lookup) {
+  nodes_.push_back(MakeNode(root, lookup));
+  AddSubpatterns(root, 0, lookup);
+}
+
+CompiledSimplePattern::Node CompiledSimplePattern::MakeNode(
+    const PatternNode& pattern_node, const Expression::LookupFn& lookup) {
+  Node node;
+  node.subpattern_type = pattern_node.subpattern_type;
+  if (!pattern_node.repeated_character_set) return node;
+
+  const RepeatedCharSet& char_set = *pattern_node.repeated_character_set;
+  node.has_repeated_character_set = true;
+  for (int c = 0; c < 128; c++)  // Use `int` over `char` to avoid overflow.
+    node.valid_chars[c] = char_set.IsValidCharacter(c);
+  try {
+    std::tie(node.min_length, node.max_length) = char_set.Extremes(lookup);
+  } catch (...) {
+    node.bounds_error = std::current_exception();
+  }
+  return node;
+}
+
+void CompiledSimplePattern::AddSubpatterns(const PatternNode& pattern_node,
+                                           int index,
                                            const Expression::LookupFn& lookup) {
-  int length = 0;
-  if (pattern_node.repeated_character_set) {
-    std::optional<int64_t> prefix_length =
-        pattern_node.repeated_character_set->LongestValidPrefix(str, lookup);
-    if (!prefix_length.has_value()) return std::nullopt;
-    str.remove_prefix(*prefix_length);
-    length += *prefix_length;
+  // All subpatterns of a node are stored contiguously.
+  const int first = nodes_.size();
+  nodes_[index].first_subpattern = first;
+  nodes_[index].num_subpatterns = pattern_node.subpatterns.size();
+  for (const PatternNode& subpattern : pattern_node.subpatterns)
+    nodes_.push_back(MakeNode(subpattern, lookup));
+  for (int i = 0; i < pattern_node.subpatterns.size(); i++)
+    AddSubpatterns(pattern_node.subpatterns[i], first + i, lookup);
+}
+
+std::optional<int64_t> CompiledSimplePattern::MatchesPrefixLength(
+    int index, std::string_view str) const {
+  const Node& node = nodes_[index];
+  int64_t length = 0;
+  if (node.has_repeated_character_set) {
+    if (node.bounds_error) std::rethrow_exception(node.bounds_error);
+    int64_t limit = std::min<int64_t>(str.size(), node.max_length);
+    int64_t idx = 0;
+    while (idx < limit && node.valid_chars[static_cast<uint8_t>(str[idx])])
+      idx++;
+    if (idx < node.min_length) return std::nullopt;
+    str.remove_prefix(idx);
+    length += idx;
   }
 
-  for (const PatternNode& subpattern : pattern_node.subpatterns) {
+  const bool any_of =
+      node.subpattern_type == PatternNode::SubpatternType::kAnyOf;
+  for (int i = 0; i < node.num_subpatterns; i++) {
     std::optional<int64_t> subpattern_length =
-        MatchesPrefixLength(subpattern, str, lookup);
+        MatchesPrefixLength(node.first_subpattern + i, str);
     if (!subpattern_length) {
-      if (pattern_node.subpattern_type == PatternNode::SubpatternType::kAllOf)
-        return std::nullopt;
+      if (!any_of) return std::nullopt;
       continue;  // We are in a kAnyOf, so we don't *have* to match this.
     }
 
     length += *subpattern_length;
+    if (any_of) return length;
+    str.remove_prefix(*subpattern_length);
+  }
+
+  // If we are in a kAnyOf, we didn't match anything...
+  if (any_of) return std::nullopt;
+  return length;
+}
 
-    if (pattern_node.subpattern_type == PatternNode::SubpatternType::kAnyOf) {
-      return length;
+bool CompiledSimplePattern::Matches(std::string_view str) const {
+  std::optional<int64_t> prefix_length = MatchesPrefixLength(0, str);
+  return prefix_length && *prefix_length == str.length();
+}
+
+std::vector<std::string> CompiledSimplePattern::NodeAlphabets(
+    std::optional<std::string_view> restricted_alphabet) const {
+  RepeatedCharSet restricted_char_set;
+  if (restricted_alphabet.has_value()) {
+    for (char c : *restricted_alphabet)
+      (void)restricted_char_set.Add(c);  // Ignore duplicates here.
+  } else {
+    restricted_char_set.FlipValidCharacters();  // Allow all characters.
+  }
+
+  std::vector<std::string> node_alphabets(nodes_.size());
+  for (int i = 0; i < nodes_.size(); i++) {
+    for (int c = 0; c < 128; c++) {
+      if (nodes_[i].valid_chars[c] && restricted_char_set.IsValidCharacter(c))
+        node_alphabets[i].push_back(c);
     }
+  }
+  return node_alphabets;
+}
 
-    str.remove_prefix(*subpattern_length);
+std::string CompiledSimplePattern::Generate(
+    std::span<const std::string> node_alphabets, const RandFn& rand) const {
+  std::string result;
+  GenerateNode(0, node_alphabets, rand, result);
+  return result;
+}
+
+void CompiledSimplePattern::GenerateNode(
+    int index, std::span<const std::string> node_alphabets, const RandFn& rand,
+    std::string& result) const {
+  const Node& node = nodes_[index];
+  if (node.has_repeated_character_set) {
+    if (node.bounds_error) std::rethrow_exception(node.bounds_error);
+    if (node.max_length == std::numeric_limits<int64_t>::max()) {
+      throw SimplePatternEvaluationError(
+          "Cannot generate with `*` or `+` or massive lengths.");
+    }
+    int64_t len = rand(node.min_length, node.max_length);
+
+    std::string_view valid_chars = node_alphabets[index];
+    if (valid_chars.empty()) {
+      // No valid characters, so the only valid string is the empty string.
+      if (node.min_length != 0) {
+        throw SimplePatternEvaluationError(
+            "No valid characters for generation, but empty string is not "
+            "allowed.");
+      }
+    } else if (valid_chars.size() == 1) {
+      result.append(len, valid_chars[0]);
+    } else {
+      // Each call to `rand` picks `chars_per_draw` characters at once, as the
+      // base-k digits of a single uniform integer in [0, k^chars_per_draw).
+      const int64_t k = valid_chars.size();
+      int chars_per_draw = 0;
+      int64_t draw_size = 1;
+      while (draw_size <= std::numeric_limits<int64_t>::max() / k) {
+        draw_size *= k;
+        chars_per_draw++;
+      }
+
+      int64_t idx = result.size();
+      result.resize(result.size() + len);
+      for (int64_t remaining = len; remaining > 0;) {
+        int count = std::min<int64_t>(remaining, chars_per_draw);
+        int64_t size = 1;
+        for (int i = 0; i < count; i++) size *= k;
+        int64_t digits = rand(0, size - 1);
+        for (int i = 0; i < count; i++, digits /= k)
+          result[idx++] = valid_chars[digits % k];
+        remaining -= count;
+      }
+    }
   }
 
-  if (pattern_node.subpattern_type == PatternNode::SubpatternType::kAnyOf) {
-    // We are in a kAnyOf, but we didn't match anything...
-    return std::nullopt;
+  if (node.num_subpatterns == 0) return;
+
+  if (node.subpattern_type == PatternNode::SubpatternType::kAnyOf) {
+    int64_t i = rand(0, node.num_subpatterns - 1);
+    GenerateNode(node.first_subpattern + i, node_alphabets, rand, result);
+    return;
   }
-  return length;
+
+  for (int i = 0; i < node.num_subpatterns; i++)
+    GenerateNode(node.first_subpattern + i, node_alphabets, rand, result);
 }
 
 SimplePattern::SimplePattern(std::string pattern) {
@@ -464,85 +595,53 @@ SimplePattern::SimplePattern(std::string pattern) {
                                   std::format("Unmatched ')' around index {}?",
                                               pattern_node_.pattern.size()));
   }
+
+  for (const std::string& dependency : GetDependencies())
+    dependencies_.push_back(dependency);
 }
 
 std::string SimplePattern::Pattern() const { return pattern_; }
 
 bool SimplePattern::Matches(std::string_view str,
                             const Expression::LookupFn& lookup) const {
-  std::optional<int64_t> prefix_length =
-      MatchesPrefixLength(pattern_node_, str, lookup);
-  return prefix_length && *prefix_length == str.length();
+  return Compile(lookup)->Matches(str);
 }
 
-namespace {
-
-std::string GenerateRepeatedCharSet(
-    const RepeatedCharSet& char_set,
-    std::optional<std::string_view> restricted_alphabet,
-    const Expression::LookupFn& lookup, const SimplePattern::RandFn& rand) {
-  auto [min, max] = char_set.Extremes(lookup);
-  if (max == std::numeric_limits<int64_t>::max()) {
-    throw SimplePatternEvaluationError(
-        "Cannot generate with `*` or `+` or massive lengths.");
-  }
-  int64_t len = rand(min, max);
-
-  RepeatedCharSet restricted_char_set;
-  if (restricted_alphabet.has_value()) {
-    for (char c : *restricted_alphabet)
-      (void)restricted_char_set.Add(c);  // Ignore duplicates here.
-  } else {
-    restricted_char_set.FlipValidCharacters();  // Allow all characters.
-  }
-  std::vector<char> valid_chars;
-  for (char c : char_set.ValidCharacters()) {
-    if (restricted_char_set.IsValidCharacter(c)) valid_chars.push_back(c);
-  }
-
-  if (valid_chars.empty()) {
-    // No valid characters, so the only valid string is the empty string.
-    if (min == 0) return "";
-    throw SimplePatternEvaluationError(
-        "No valid characters for generation, but empty string is not "
-        "allowed.");
-  }
-
-  std::string result;
-  while (result.size() < len) {
-    int64_t idx = rand(0, (int)valid_chars.size() - 1);
-    result.push_back(valid_chars[idx]);
-  }
-  return std::string(result.begin(), result.end());
-}
-
-std::string GeneratePatternNode(
-    const PatternNode& node,
-    std::optional<std::string_view> restricted_alphabet,
-    const Expression::LookupFn& lookup, const SimplePattern::RandFn& rand) {
-  std::string result =
-      node.repeated_character_set
-          ? GenerateRepeatedCharSet(*node.repeated_character_set,
-                                    restricted_alphabet, lookup, rand)
-          : "";
-
-  if (node.subpatterns.empty()) return result;
-
-  if (node.subpattern_type == PatternNode::SubpatternType::kAnyOf) {
-    int64_t idx = rand(0, (int)node.subpatterns.size() - 1);
-    std::string subresult = GeneratePatternNode(
-        node.subpatterns[idx], restricted_alphabet, lookup, rand);
-    return result + subresult;
-  }
-
-  for (const PatternNode& subpattern : node.subpatterns) {
-    std::string subresult =
-        GeneratePatternNode(subpattern, restricted_alphabet, lookup, rand);
-    result += subresult;
-  }
+std::shared_ptr<const CompiledSimplePattern> SimplePattern::Compile(
+    const Expression::LookupFn& lookup) const {
+  std::vector<int64_t> values;
+  values.reserve(dependencies_.size());
+  bool all_known = true;
+  try {
+    for (const std::string& dependency : dependencies_)
+      values.push_back(lookup(dependency));
+  } catch (const VariableNotFound&) {
+    all_known = false;
+  } catch (const ValueNotFound&) {
+    all_known = false;
+  }
+  if (!all_known) {
+    // Some variable is unknown. It may not be needed to match, so compile
+    // anyway (errors are deferred until the node is reached), but don't cache.
+    return std::make_shared<const CompiledSimplePattern>(pattern_node_, lookup);
+  }
+
+  std::lock_guard lock(compiled_cache_->mutex);
+  auto& compiled = compiled_cache_->compiled;
+  if (auto it = compiled.find(values); it != compiled.end()) return it->second;
+
+  // Patterns whose variables change every time (e.g., "[a-z]{N}" over many
+  // test cases) would otherwise grow the cache without bound.
+  static constexpr int kMaxCachedCompilations = 64;
+  if (compiled.size() >= kMaxCachedCompilations) compiled.clear();
+  auto result =
+      std::make_shared<const CompiledSimplePattern>(pattern_node_, lookup);
+  compiled.emplace(std::move(values), result);
   return result;
 }
 
+namespace {
+
 Dependencies ExtractDependencies(const PatternNode& node) {
   Dependencies dependencies;
   for (const PatternNode& subpattern : node.subpatterns)
@@ -564,7 +663,26 @@ std::string SimplePattern::Generate(const Expression::LookupFn& lookup,
 std::string SimplePattern::GenerateWithRestrictions(
     std::optional<std::string_view> restricted_alphabet,
     const Expression::LookupFn& lookup, const RandFn& rand) const {
-  return GeneratePatternNode(pattern_node_, restricted_alphabet, lookup, rand);
+  std::shared_ptr<const CompiledSimplePattern> compiled = Compile(lookup);
+  return compiled->Generate(*NodeAlphabets(*compiled, restricted_alphabet),
+                            rand);
+}
+
+std::shared_ptr<const std::vector<std::string>> SimplePattern::NodeAlphabets(
+    const CompiledSimplePattern& compiled,
+    std::optional<std::string_view> restricted_alphabet) const {
+  std::optional<std::string> key(restricted_alphabet);
+  std::lock_guard lock(compiled_cache_->mutex);
+  auto& node_alphabets = compiled_cache_->node_alphabets;
+  if (auto it = node_alphabets.find(key); it != node_alphabets.end())
+    return it->second;
+
+  static constexpr int kMaxCachedAlphabets = 64;
+  if (node_alphabets.size() >= kMaxCachedAlphabets) node_alphabets.clear();
+  auto result = std::make_shared<const std::vector<std::string>>(
+      compiled.NodeAlphabets(restricted_alphabet));
+  node_alphabets.emplace(std::move(key), result);
+  return result;
 }
 
 Dependencies SimplePattern::GetDependencies() const {
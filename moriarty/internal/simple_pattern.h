@@ -16,10 +16,16 @@
 #ifndef MORIARTY_INTERNAL_SIMPLE_PATTERN_H_
 #define MORIARTY_INTERNAL_SIMPLE_PATTERN_H_
 
+#include <array>
 #include <bitset>
 #include <cstdint>
+#include <exception>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -89,6 +95,76 @@ struct PatternNode {
   std::string_view pattern;
 };
 
+// CompiledSimplePattern [class]
+//
+// A SimplePattern whose repetition bounds have been evaluated for one set of
+// variable values. The PatternNode tree is flattened into an array and each
+// character set becomes a lookup table, so matching never evaluates an
+// Expression.
+//
+// Matches() accepts exactly the same strings as SimplePattern::Matches() (same
+// greedy semantics, same errors). Use SimplePattern::Compile() to create one.
+class CompiledSimplePattern {
+ public:
+  // Function that returns a random integer in the range [min, max] (inclusive).
+  using RandFn = std::function<int64_t(int64_t, int64_t)>;
+
+  CompiledSimplePattern(const PatternNode& root,
+                        const Expression::LookupFn& lookup);
+
+  // Matches()
+  //
+  // Determines if `str` matches the pattern. Each node of the pattern is
+  // attempted at most once, and each attempt is a single scan, so the time is
+  // linear in `str` for a fixed pattern.
+  [[nodiscard]] bool Matches(std::string_view str) const;
+
+  // NodeAlphabets()
+  //
+  // Returns, for each node, the characters that node may generate: its
+  // character set, intersected with `restricted_alphabet` (if set). These do
+  // not depend on variable values, so may be reused with any compilation of
+  // the same SimplePattern.
+  [[nodiscard]] std::vector<std::string> NodeAlphabets(
+      std::optional<std::string_view> restricted_alphabet) const;
+
+  // Generate()
+  //
+  // Generates a string which matches the pattern, where each node only uses
+  // the characters in `node_alphabets` (from NodeAlphabets()). All randomness
+  // comes from `rand`.
+  [[nodiscard]] std::string Generate(
+      std::span<const std::string> node_alphabets, const RandFn& rand) const;
+
+ private:
+  struct Node {
+    bool has_repeated_character_set = false;
+    std::array<bool, 256> valid_chars = {};  // Indexed by `unsigned char`.
+    int64_t min_length = 0;
+    int64_t max_length = 0;
+    // If evaluating the repetition bounds failed, the error is rethrown when
+    // (and only when) this node is reached while matching.
+    std::exception_ptr bounds_error;
+
+    PatternNode::SubpatternType subpattern_type =
+        PatternNode::SubpatternType::kAllOf;
+    // The subpatterns are nodes_[first_subpattern, first_subpattern + size).
+    int first_subpattern = 0;
+    int num_subpatterns = 0;
+  };
+
+  static Node MakeNode(const PatternNode& pattern_node,
+                       const Expression::LookupFn& lookup);
+  void AddSubpatterns(const PatternNode& pattern_node, int index,
+                      const Expression::LookupFn& lookup);
+  std::optional<int64_t> MatchesPrefixLength(int index,
+                                             std::string_view str) const;
+  void GenerateNode(int index, std::span<const std::string> node_alphabets,
+                    const RandFn& rand, std::string& result) const;
+
+  std::vector<Node> nodes_;  // nodes_[0] is the root.
+};
+
 // SimplePattern [class]
 //
 // Represents a very simplified expression checker. It is *NOT* equivalent to
@@ -159,7 +235,7 @@ struct PatternNode {
 class SimplePattern {
  public:
   // Function that returns a random integer in the range [min, max] (inclusive).
-  using RandFn = std::function<int64_t(int64_t, int64_t)>;
+  using RandFn = CompiledSimplePattern::RandFn;
 
   explicit SimplePattern(std::string pattern);
 
@@ -183,9 +259,22 @@ class SimplePattern {
   //
   //  patternC = "(hello|helloworld)"
   //  strC     = "helloworld"      <-- "hello" matches the left or-expression.
+  //
+  // Matching uses the CompiledSimplePattern for the current values of
+  // GetDependencies(), which is cached. Matching many strings with the same
+  // variable values only evaluates the pattern's Expressions once.
   [[nodiscard]] bool Matches(std::string_view str,
                              const Expression::LookupFn& lookup) const;
 
+  // Compile()
+  //
+  // Returns this pattern with all repetition bounds evaluated using `lookup`.
+  // The result is cached per value of the variables in GetDependencies(), so
+  // calling this repeatedly with the same values returns the same object.
+  // Thread-safe.
+  [[nodiscard]] std::shared_ptr<const CompiledSimplePattern> Compile(
+      const Expression::LookupFn& lookup) const;
+
   // Generate()
   //
   // Generates a string which matches the underlying pattern.
@@ -206,6 +295,10 @@ class SimplePattern {
   //
   // If `restricted_alphabet` is set, the generated string will only contain
   // characters from that string.
+  //
+  // The per-node character tables for each `restricted_alphabet` and the
+  // repetition bounds for each set of variable values are cached, so
+  // generating many strings from the same pattern is cheap.
   [[nodiscard]] std::string GenerateWithRestrictions(
       std::optional<std::string_view> restricted_alphabet,
       const Expression::LookupFn& lookup, const RandFn& rand) const;
@@ -218,6 +311,26 @@ class SimplePattern {
  private:
   std::string pattern_;
   PatternNode pattern_node_;
+  std::vector<std::string> dependencies_;
+
+  // Compiled forms of this pattern, keyed by the values of `dependencies_`,
+  // and the NodeAlphabets() for each restricted alphabet. Shared between
+  // copies, since they have the same pattern.
+  struct CompiledCache {
+    std::mutex mutex;
+    std::map<std::vector<int64_t>,
+             std::shared_ptr<const CompiledSimplePattern>>
+        compiled;
+    std::map<std::optional<std::string>,
+             std::shared_ptr<const std::vector<std::string>>>
+        node_alphabets;
+  };
+  std::shared_ptr<const std::vector<std::string>> NodeAlphabets(
+      const CompiledSimplePattern& compiled,
+      std::optional<std::string_view> restricted_alphabet) const;
+
+  std::shared_ptr<CompiledCache> compiled_cache_ =
+      std::make_shared<CompiledCache>();
 };
 
 // Returns the length of the prefix that corresponds to a character set. This
@@ -19,9 +19,9 @@
 #include <limits>
 #include <optional>
 #include <ostream>
-#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -54,6 +54,7 @@ namespace {
 using ::moriarty_testing::Context;
 using ::testing::AllOf;
 using ::testing::AnyOf;
+using ::testing::Contains;
 using ::testing::Eq;
 using ::testing::ExplainMatchResult;
 using ::testing::Field;
@@ -63,6 +64,7 @@ using ::testing::HasSubstr;
 using ::testing::IsEmpty;
 using ::testing::Le;
 using ::testing::Matches;
+using ::testing::MatchesRegex;
 using ::testing::Not;
 using ::testing::Optional;
 using ::testing::SizeIs;
@@ -78,7 +80,7 @@ SimplePattern::RandFn Random() {
 
 Expression::LookupFn EmptyLookup() {
   return [](std::string_view) -> int64_t {
-    throw std::runtime_error("Empty lookup function");
+    throw VariableNotFound("Empty lookup function");
   };
 }
 
@@ -391,6 +393,68 @@ TEST(SimplePatternTest, FunctionsInRangeSizesShouldWork) {
       AllOf(SimplePatternMatches("a", ctx), SimplePatternMatches("aa", ctx)));
 }
 
+Expression::LookupFn MapLookup(std::vector<std::pair<std::string, int64_t>> v) {
+  return [v = std::move(v)](std::string_view var) -> int64_t {
+    for (const auto& [name, value] : v)
+      if (name == var) return value;
+    throw VariableNotFound(var);
+  };
+}
+
+TEST(SimplePatternTest, CompileShouldBeCachedPerVariableValue) {
+  SimplePattern p("[a-z]{1,N}[xy]*");
+  auto n5 = p.Compile(MapLookup({{"N", 5}}));
+  auto n6 = p.Compile(MapLookup({{"N", 6}}));
+  EXPECT_EQ(p.Compile(MapLookup({{"N", 5}})), n5);
+  EXPECT_NE(n5, n6);
+
+  EXPECT_TRUE(n5->Matches("abcdexy"));
+  EXPECT_FALSE(n5->Matches("abcdefxy"));
+  EXPECT_TRUE(n6->Matches("abcdefxy"));
+
+  SimplePattern copy = p;
+  EXPECT_EQ(copy.Compile(MapLookup({{"N", 6}})), n6);
+}
+
+TEST(SimplePatternTest, InvalidRangesShouldOnlyThrowWhenReached) {
+  SimplePattern p("a|b{N,M}");
+  Expression::LookupFn lookup = MapLookup({{"N", 5}, {"M", 3}});
+  EXPECT_TRUE(p.Matches("a", lookup));
+  EXPECT_THROW((void)p.Matches("b", lookup), SimplePatternEvaluationError);
+
+  // Unknown variables are only looked up if their node is reached.
+  EXPECT_TRUE(p.Matches("a", EmptyLookup()));
+  EXPECT_THROW((void)p.Matches("b", EmptyLookup()), VariableNotFound);
+}
+
+TEST(SimplePatternTest, CompileShouldOnlyDeferMissingVariables) {
+  SimplePattern p("a|b{N}");
+  auto failing_lookup = [](std::string_view var) -> int64_t {
+    throw GenerationError(var, "cannot generate", RetryPolicy::kAbort);
+  };
+  EXPECT_THROW((void)p.Compile(failing_lookup), GenerationError);
+  EXPECT_THROW((void)p.Matches("a", failing_lookup), GenerationError);
+
+  auto missing_value = [](std::string_view var) -> int64_t {
+    throw ValueNotFound(var);
+  };
+  EXPECT_TRUE(p.Matches("a", missing_value));
+}
+
+TEST(SimplePatternTest, MatchingManyLongStringsShouldBeFast) {
+  SimplePattern p("[a-z]{1,N}(x|y)[xy]*");
+  Expression::LookupFn lookup = MapLookup({{"N", 1000}});
+
+  std::string good = std::string(1000, 'q') + std::string(1000, 'x');
+  std::string bad = std::string(1001, 'q') + std::string(999, 'x');
+  int num_matches = 0;
+  for (int i = 0; i < 10000; i++) {
+    num_matches += p.Matches(good, lookup);
+    num_matches += p.Matches(bad, lookup);
+  }
+  EXPECT_EQ(num_matches, 10000);
+}
+
 // GeneratedStringsAre() [for use with GoogleTest]
 //
 // Checks if the subpatterns of a PatternNode are as expected.
@@ -532,6 +596,33 @@ TEST(SimplePatternTest,
                     "not allowed.")));
 }
 
+TEST(SimplePatternTest, GenerationShouldDrawManyCharactersPerRandomCall) {
+  SimplePattern p("[a-z]{1000}");
+  SimplePattern::RandFn random = Random();
+  int num_calls = 0;
+  SimplePattern::RandFn counting_random = [&](int64_t lo, int64_t hi) {
+    num_calls++;
+    return random(lo, hi);
+  };
+
+  std::string value = p.Generate(EmptyLookup(), counting_random);
+  EXPECT_THAT(value, SizeIs(1000));
+  EXPECT_TRUE(p.Matches(value, EmptyLookup()));
+  for (char c = 'a'; c <= 'z'; c++) EXPECT_THAT(value, Contains(c));
+  // 26^13 < 2^63, so 13 characters per call (plus one call for the length).
+  EXPECT_EQ(num_calls, 1 + (1000 + 12) / 13);
+}
+
+TEST(SimplePatternTest, GenerationShouldReuseRestrictedAlphabetsCorrectly) {
+  SimplePattern p("[a-z]{5}[0-9]{3}");
+  for (int i = 0; i < 20; i++) {
+    EXPECT_THAT(p.GenerateWithRestrictions("ab0", EmptyLookup(), Random()),
+                MatchesRegex("[ab]{5}000"));
+    EXPECT_THAT(p.GenerateWithRestrictions("z19", EmptyLookup(), Random()),
+                MatchesRegex("z{5}[19]{3}"));
+  }
+}
+
 TEST(SimplePatternTest, GeneratingVariablesInRangeSizesShouldWork) {
   EXPECT_THAT("a{N}",
               GeneratedStringsAre("a", Context().WithValue<MInteger>("N", 1)));
@@ -21,6 +21,7 @@
 
 #include "moriarty/constraints/constraint_violation.h"
 #include "moriarty/context.h"
+#include "moriarty/librarian/dependencies.h"
 #include "moriarty/librarian/util/cow_ptr.h"
 
 namespace moriarty {
@@ -53,6 +54,13 @@ class ConstraintHandler {
   ValidationResult Validate(ConstraintContext ctx,
                             const ValueType& value) const;
 
+  // Validate()
+  //
+  // Same as above, but if a constraint is not satisfied, `failing_dependencies`
+  // is set to the dependencies of that constraint.
+  ValidationResult Validate(ConstraintContext ctx, const ValueType& value,
+                            Dependencies& failing_dependencies) const;
+
   // ToString()
   //
   // Returns a string representation of the constraints.
@@ -70,6 +78,7 @@ class ConstraintHandler {
     virtual auto Validate(ConstraintContext ctx, const ValueType& value) const
         -> ValidationResult = 0;
     virtual auto ToString() const -> std::string = 0;
+    virtual auto GetDependencies() const -> Dependencies = 0;
     virtual auto ApplyTo(VariableType& other) const -> void = 0;
   };
 
@@ -86,6 +95,9 @@ class ConstraintHandler {
     auto ToString() const -> std::string override {
       return constraint_.ToString();
     }
+    auto GetDependencies() const -> Dependencies override {
+      return constraint_.GetDependencies();
+    }
     auto ApplyTo(VariableType& other) const -> void override {
       if constexpr (ConstraintHasCustomApplyToFn<U, VariableType>) {
         constraint_.ApplyTo(other);
@@ -123,6 +135,19 @@ ValidationResult ConstraintHandler<VariableType, ValueType>::Validate(
   return ValidationResult::Ok();
 }
 
+template <typename VariableType, typename ValueType>
+ValidationResult ConstraintHandler<VariableType, ValueType>::Validate(
+    ConstraintContext ctx, const ValueType& value,
+    Dependencies& failing_dependencies) const {
+  for (const auto& constraint : constraints_) {
+    if (auto v = constraint->Validate(ctx, value); !v.IsOk()) {
+      failing_dependencies = constraint->GetDependencies();
+      return v;
+    }
+  }
+  return ValidationResult::Ok();
+}
+
 template <typename VariableType, typename ValueType>
 auto ConstraintHandler<VariableType, ValueType>::ToString() const
     -> std::string {
@@ -20,6 +20,7 @@
 #include "moriarty/context.h"
 #include "moriarty/internal/value_set.h"
 #include "moriarty/internal/variable_set.h"
+#include "moriarty/librarian/dependencies.h"
 #include "moriarty/librarian/testing/gtest_helpers.h"
 #include "moriarty/variables/minteger.h"
 #include "moriarty/variables/mstring.h"
@@ -34,7 +35,9 @@ using ::moriarty_testing::HasNoViolation;
 using ::moriarty_testing::HasViolation;
 using ::testing::AllOf;
 using ::testing::AnyOf;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 using ::testing::Not;
 
 struct Even {
@@ -43,6 +46,7 @@ struct Even {
     return ctx.Violation(value, {.expected = "even"});
   }
   std::string ToString() const { return "is even"; }
+  Dependencies GetDependencies() const { return Dependencies(); }
   void ApplyTo(MInteger& other) const { throw "unimplemented"; }
 };
 
@@ -52,6 +56,17 @@ struct Positive {
     return ctx.Violation(value, {.expected = "positive"});
   }
   std::string ToString() const { return "is positive"; }
+  Dependencies GetDependencies() const { return Dependencies(); }
+  void ApplyTo(MInteger& other) const { throw "unimplemented"; }
+};
+
+struct NotEqualToN {
+  ValidationResult Validate(ConstraintContext ctx, int value) const {
+    if (value != ctx.GetValue<MInteger>("N")) return ValidationResult::Ok();
+    return ctx.Violation(value, {.expected = "not N"});
+  }
+  std::string ToString() const { return "is not N"; }
+  Dependencies GetDependencies() const { return Dependencies({"N"}); }
   void ApplyTo(MInteger& other) const { throw "unimplemented"; }
 };
 
@@ -127,6 +142,28 @@ TEST(ConstraintHandlerTest, ValidateShouldReturnIfAnyFail) {
   EXPECT_THAT(handler.Validate(ctx, 10), HasNoViolation());
 }
 
+TEST(ConstraintHandlerTest, ValidateShouldReportDependenciesOfTheFailure) {
+  moriarty_internal::VariableSet variables;
+  moriarty_internal::ValueSet values;
+  values.Set<MInteger>("N", 4);
+  ConstraintContext ctx("X", variables, values);
+
+  ConstraintHandler<MInteger, int> handler;
+  handler.AddConstraint(Positive());
+  handler.AddConstraint(NotEqualToN());
+
+  Dependencies failing_dependencies;
+  EXPECT_THAT(handler.Validate(ctx, 4, failing_dependencies),
+              HasViolation(HasSubstr("not N")));
+  EXPECT_THAT(failing_dependencies, ElementsAre("N"));
+
+  EXPECT_THAT(handler.Validate(ctx, -4, failing_dependencies),
+              HasViolation(HasSubstr("positive")));
+  EXPECT_THAT(failing_dependencies, IsEmpty());
+
+  EXPECT_THAT(handler.Validate(ctx, 5, failing_dependencies), HasNoViolation());
+}
+
 }  // namespace
 }  // namespace librarian
 }  // namespace moriarty
@@ -26,6 +26,7 @@
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -254,15 +255,34 @@ class MVariable : public moriarty_internal::AbstractVariable {
   // Returns the OneOfHandler for this variable.
   [[nodiscard]] const OneOfHandler<value_type>& GetOneOf() const;
 
+  // HasCustomConstraints()
+  //
+  // Returns true if any custom constraint (see `AddCustomConstraint()`) has
+  // been added to this variable. Librarians may use this to take shortcuts that
+  // are only valid for the built-in constraints.
+  [[nodiscard]] bool HasCustomConstraints() const;
+
  private:
   ConstraintHandler<VariableType, value_type> constraints_;
   OneOfHandler<value_type> one_of_;
   Dependencies dependencies_;
+  bool has_custom_constraints_ = false;
 
   // Helper function that casts *this to `VariableType`.
   [[nodiscard]] VariableType& UnderlyingVariableType();
   [[nodiscard]] const VariableType& UnderlyingVariableType() const;
-  [[nodiscard]] value_type GenerateOnce(GenerateVariableContext ctx) const;
+
+  // The result of a single generation attempt: either a value or the reason
+  // the attempt was rejected. Rejections are common when constraints are tight,
+  // so they are returned rather than thrown.
+  struct GenerationAttempt {
+    std::optional<value_type> value;
+    // Only meaningful if `value` is not set.
+    std::string failure_reason;
+    Dependencies failing_dependencies;  // Of the unsatisfied constraint.
+  };
+  [[nodiscard]] GenerationAttempt GenerateOnce(
+      GenerateVariableContext ctx) const;
 
   // ---------------------------------------------------------------------------
   //  AbstractVariable overrides
@@ -381,6 +401,7 @@ V& MVariable<V>::AddCustomConstraint(
 
 template <typename V>
 V& MVariable<V>::AddConstraint(CustomConstraint<V> constraint) {
+  has_custom_constraints_ = true;
   return InternalAddConstraint(CustomConstraintWrapper(std::move(constraint)));
 }
 
@@ -411,34 +432,52 @@ auto MVariable<V>::Generate(GenerateVariableContext ctx) const -> value_type {
 
   ctx.MarkStartGeneration(name);
 
-  auto report_and_clean = [&](std::string_view failure_reason) {
-    auto [should_retry, delete_variables] =
-        ctx.ReportGenerationFailure(std::string(failure_reason));
-    for (std::string_view variable_name : delete_variables)
-      ctx.EraseValue(variable_name);
-    return should_retry;
-  };
+  auto report_and_clean =
+      [&](std::string_view failure_reason,
+          std::optional<std::span<const std::string>> culprits = std::nullopt) {
+        auto [should_retry, delete_variables] =
+            ctx.ReportGenerationFailure(std::string(failure_reason), culprits);
+        for (std::string_view variable_name : delete_variables)
+          ctx.EraseValue(variable_name);
+        return should_retry;
+      };
 
   std::exception_ptr last_exception;
+  std::string last_failure_reason;
+  Dependencies failing_dependencies;
   while (true) {
     try {
-      value_type value = GenerateOnce(ctx);
-      ctx.MarkSuccessfulGeneration();
-      return value;
+      GenerationAttempt attempt = GenerateOnce(ctx);
+      if (attempt.value.has_value()) {
+        ctx.MarkSuccessfulGeneration();
+        return *std::move(attempt.value);
+      }
+      last_exception = nullptr;
+      last_failure_reason = std::move(attempt.failure_reason);
+      failing_dependencies = std::move(attempt.failing_dependencies);
     } catch (const GenerationError& e) {
       last_exception = std::current_exception();
       RetryPolicy retry = report_and_clean(e.Message());
       if (retry == RetryPolicy::kAbort) break;
       if (e.IsRetryable() == RetryPolicy::kAbort) break;
+      continue;
     } catch (const std::exception& e) {
       report_and_clean(e.what());
       ctx.MarkAbandonedGeneration();
       throw;  // Re-throw unknown messages.
     }
+    // Only the variables feeding the unsatisfied constraint need to be
+    // regenerated.
+    std::span<const std::string> culprits(failing_dependencies.data(),
+                                          failing_dependencies.size());
+    if (report_and_clean(last_failure_reason, culprits) == RetryPolicy::kAbort)
+      break;
   }
 
   ctx.MarkAbandonedGeneration();
-  std::rethrow_exception(last_exception);
+  if (last_exception) std::rethrow_exception(last_exception);
+  throw GenerationError(ctx.GetLocalVariableName(), last_failure_reason,
+                        RetryPolicy::kRetry);
 }
 
 template <typename V>
@@ -451,8 +490,9 @@ auto MVariable<V>::GetUniqueValue(AnalyzeVariableContext ctx) const
   try {
     return GetUniqueValueImpl(ctx);
   } catch (const ValueNotFound&) {
-    // Many places can throw a value not found error, but this isn't an error in
-    // this context, since it may be generated later.
+    // Librarians should return std::nullopt when a value they need is not known
+    // (yet), but some helpers still throw. This isn't an error in this context,
+    // since it may be generated later.
     return std::nullopt;
   }
 }
@@ -580,6 +620,11 @@ auto MVariable<V>::GetOneOf() const -> const OneOfHandler<value_type>& {
   return one_of_;
 }
 
+template <typename V>
+bool MVariable<V>::HasCustomConstraints() const {
+  return has_custom_constraints_;
+}
+
 // -----------------------------------------------------------------------------
 //  Template implementation for private functions not part of Extended API.
 
@@ -601,22 +646,25 @@ std::unique_ptr<moriarty_internal::AbstractVariable> MVariable<V>::Clone()
 }
 
 template <typename V>
-typename MVariable<V>::value_type MVariable<V>::GenerateOnce(
-    GenerateVariableContext ctx) const {
+auto MVariable<V>::GenerateOnce(GenerateVariableContext ctx) const
+    -> GenerationAttempt {
   value_type potential_value = GenerateImpl(ctx);
 
   // Some dependent variables may not have been generate, but are required to
   // validate. Generate them now.
   for (std::string_view dep : dependencies_) ctx.AssignVariable(dep);
 
-  if (auto v = Validate(ConstraintContext(ctx), potential_value); !v.IsOk())
-    throw moriarty::GenerationError(
-        ctx.GetLocalVariableName(),
-        std::format("Generated value does not satisfy constraints:\n{}",
-                    v.PrettyReason()),
-        RetryPolicy::kRetry);
+  Dependencies failing_dependencies;
+  if (auto v = constraints_.Validate(ConstraintContext(ctx), potential_value,
+                                     failing_dependencies);
+      !v.IsOk()) {
+    return {.failure_reason = std::format(
+                "Generated value does not satisfy constraints:\n{}",
+                v.PrettyReason()),
+            .failing_dependencies = std::move(failing_dependencies)};
+  }
 
-  return potential_value;
+  return {.value = std::move(potential_value)};
 }
 
 template <typename V>
@@ -631,6 +679,7 @@ void MVariable<V>::AssignValue(
 
   if (ctx.ValueIsKnown(ctx.GetLocalVariableName())) return;
   ctx.SetValue<V>(ctx.GetLocalVariableName(), Generate(ctx));
+  ctx.MarkValueStored(ctx.GetLocalVariableName());
 }
 
 template <typename V>
@@ -0,0 +1,157 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_TYPES_COLUMNS_H_
+#define MORIARTY_TYPES_COLUMNS_H_
+
+#include <cstddef>
+#include <format>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "moriarty/internal/value_printer.h"
+
+namespace moriarty {
+
+// Columns
+//
+// A list of tuples, stored column-by-column: the I-th component of every tuple
+// is stored in its own contiguous vector. Logically equivalent to
+// `std::vector<std::tuple<T...>>`, but each component can be scanned without
+// touching the others.
+//
+// E.g., an edge list `Columns<int64_t, int64_t, int64_t>` stores the sources,
+// targets and weights in three separate vectors.
+template <typename... T>
+class Columns {
+ public:
+  using row_type = std::tuple<T...>;
+  // A view of a single row. Invalidated by any non-const call to `Columns`.
+  using row_view_type = std::tuple<const T&...>;
+  template <size_t I>
+  using column_type = std::vector<std::tuple_element_t<I, row_type>>;
+
+  // Constructs an empty list.
+  Columns() = default;
+
+  // Constructs the list from each of its columns. All columns must have the
+  // same length.
+  explicit Columns(std::vector<T>... columns)
+    requires(sizeof...(T) > 0);
+
+  // Constructs the list from its rows.
+  explicit Columns(const std::vector<row_type>& rows);
+
+  // Returns the number of rows.
+  [[nodiscard]] size_t size() const { return std::get<0>(columns_).size(); }
+
+  // Returns whether there are no rows.
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  // Returns the I-th column.
+  template <size_t I>
+  [[nodiscard]] const column_type<I>& Column() const {
+    return std::get<I>(columns_);
+  }
+
+  // Returns a view of row `idx` (0-based). No bounds checking is done.
+  [[nodiscard]] row_view_type operator[](size_t idx) const;
+
+  // Returns a range of views of each row, in order.
+  //
+  // E.g., for (const auto& [u, v, w] : edges.Rows()) { ... }
+  [[nodiscard]] auto Rows() const {
+    return std::views::iota(size_t{0}, size()) |
+           std::views::transform([this](size_t idx) { return (*this)[idx]; });
+  }
+
+  // Reserves space for `num_rows` rows in each column.
+  void reserve(size_t num_rows);
+
+  // Appends `row` to the end of the list.
+  void push_back(const row_type& row);
+
+  // Returns the rows as a vector of tuples.
+  [[nodiscard]] std::vector<row_type> ToTuples() const;
+
+  bool operator==(const Columns& other) const = default;
+
+  friend std::string PrettyPrintValue(const Columns& C, int max_len) {
+    return std::format(
+        "Columns({})",
+        moriarty_internal::ValuePrinter(C.ToTuples(), max_len - 9));
+  }
+
+ private:
+  std::tuple<std::vector<T>...> columns_;
+};
+
+// -----------------------------------------------------------------------------
+//  Template implementation below
+
+template <typename... T>
+Columns<T...>::Columns(std::vector<T>... columns)
+  requires(sizeof...(T) > 0)
+    : columns_(std::move(columns)...) {
+  bool same_size = std::apply(
+      [this](const auto&... column) {
+        return ((column.size() == size()) && ...);
+      },
+      columns_);
+  if (!same_size) {
+    throw std::invalid_argument("Columns(): all columns must have equal size.");
+  }
+}
+
+template <typename... T>
+Columns<T...>::Columns(const std::vector<row_type>& rows) {
+  reserve(rows.size());
+  for (const row_type& row : rows) push_back(row);
+}
+
+template <typename... T>
+auto Columns<T...>::operator[](size_t idx) const -> row_view_type {
+  return std::apply(
+      [idx](const auto&... column) { return row_view_type(column[idx]...); },
+      columns_);
+}
+
+template <typename... T>
+void Columns<T...>::reserve(size_t num_rows) {
+  std::apply([num_rows](auto&... column) { (column.reserve(num_rows), ...); },
+             columns_);
+}
+
+template <typename... T>
+void Columns<T...>::push_back(const row_type& row) {
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (std::get<I>(columns_).push_back(std::get<I>(row)), ...);
+  }(std::index_sequence_for<T...>{});
+}
+
+template <typename... T>
+auto Columns<T...>::ToTuples() const -> std::vector<row_type> {
+  std::vector<row_type> rows;
+  rows.reserve(size());
+  for (size_t i = 0; i < size(); i++) rows.push_back(row_type((*this)[i]));
+  return rows;
+}
+
+}  // namespace moriarty
+
+#endif  // MORIARTY_TYPES_COLUMNS_H_
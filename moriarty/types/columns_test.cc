@@ -0,0 +1,84 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/types/columns.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace moriarty {
+namespace {
+
+using testing::ElementsAre;
+using testing::FieldsAre;
+using testing::IsEmpty;
+
+TEST(ColumnsTest, DefaultConstructorGivesEmptyList) {
+  Columns<int64_t, std::string> columns;
+  EXPECT_EQ(columns.size(), 0);
+  EXPECT_TRUE(columns.empty());
+  EXPECT_THAT(columns.Column<0>(), IsEmpty());
+  EXPECT_THAT(columns.Column<1>(), IsEmpty());
+}
+
+TEST(ColumnsTest, ConstructingFromColumnsWorks) {
+  Columns<int64_t, std::string> columns({1, 2, 3}, {"a", "b", "c"});
+  EXPECT_EQ(columns.size(), 3);
+  EXPECT_THAT(columns.Column<0>(), ElementsAre(1, 2, 3));
+  EXPECT_THAT(columns.Column<1>(), ElementsAre("a", "b", "c"));
+}
+
+TEST(ColumnsTest, ConstructingFromRowsWorks) {
+  std::vector<std::tuple<int64_t, std::string>> rows = {{1, "a"}, {2, "b"}};
+  EXPECT_EQ((Columns<int64_t, std::string>(rows)),
+            (Columns<int64_t, std::string>({1, 2}, {"a", "b"})));
+}
+
+TEST(ColumnsTest, ColumnsOfDifferentSizesShouldThrow) {
+  EXPECT_THROW((Columns<int64_t, int64_t>({1, 2, 3}, {1, 2})),
+               std::invalid_argument);
+}
+
+TEST(ColumnsTest, RowsArePresentedAsTuples) {
+  Columns<int64_t, int64_t, int64_t> edges({1, 2}, {3, 4}, {5, 6});
+  EXPECT_THAT(edges[1], FieldsAre(2, 4, 6));
+
+  int64_t total_weight = 0;
+  for (const auto& [u, v, w] : edges.Rows()) total_weight += w;
+  EXPECT_EQ(total_weight, 11);
+}
+
+TEST(ColumnsTest, PushBackAppendsToEachColumn) {
+  Columns<int64_t, std::string> columns;
+  columns.push_back({5, "x"});
+  columns.push_back({7, "y"});
+  EXPECT_THAT(columns.Column<0>(), ElementsAre(5, 7));
+  EXPECT_THAT(columns.Column<1>(), ElementsAre("x", "y"));
+}
+
+TEST(ColumnsTest, ToTuplesReturnsAllRowsInOrder) {
+  Columns<int64_t, std::string> columns({1, 2}, {"a", "b"});
+  EXPECT_THAT(columns.ToTuples(),
+              ElementsAre(std::tuple<int64_t, std::string>(1, "a"),
+                          std::tuple<int64_t, std::string>(2, "b")));
+}
+
+}  // namespace
+}  // namespace moriarty
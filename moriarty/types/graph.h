@@ -15,10 +15,15 @@
 #ifndef MORIARTY_TYPES_GRAPH_H_
 #define MORIARTY_TYPES_GRAPH_H_
 
+#include <atomic>
 #include <cstdint>
 #include <format>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "moriarty/internal/value_printer.h"
@@ -59,6 +64,13 @@ class Graph {
   // Constructs a graph with `num_nodes` nodes.
   explicit Graph(NodeIdx num_nodes);
 
+  Graph(const Graph&) = default;
+  Graph& operator=(const Graph&) = default;
+
+  // Moving leaves `other` as a valid graph with no nodes.
+  Graph(Graph&& other) noexcept;
+  Graph& operator=(Graph&& other) noexcept;
+
   // Returns the number of nodes in the graph.
   [[nodiscard]] NodeIdx NumNodes() const { return num_nodes_; }
 
@@ -75,17 +87,34 @@ class Graph {
   NodeIdx GetOrAddNodeIndex(const NodeLabel& node_label);
 
   // Returns the labels for all nodes in the graph.
-  std::vector<NodeLabel> GetNodeLabels() const;
+  const std::vector<NodeLabel>& GetNodeLabels() const;
 
   // Adds an undirected edge between nodes `u` and `v`.
   Graph& AddEdge(NodeIdx u, NodeIdx v, EdgeLabel edge_label = {});
 
+  // Reserves space for `num_edges` edges in total.
+  void ReserveEdges(int64_t num_edges);
+
+  // Returns the edges incident to `node`, oriented so that each has
+  // edge.u == node. A loop at `node` appears once.
+  //
+  // The first call after the graph changes builds a compressed (CSR) adjacency
+  // for every node in O(n + m). Later calls are O(1). The view is invalidated
+  // by any non-const call to the graph.
+  [[nodiscard]] std::span<const Edge> AdjacentEdges(NodeIdx node) const;
+
   // Returns the adjacency list representation of the graph.
   // The order of (u, v) will be altered so that adj[i][j].u == i.
+  //
+  // This copies every edge. Prefer AdjacentEdges().
   std::vector<std::vector<Edge>> GetAdjacencyList() const;
 
-  // Returns all edges in the graph. There is no guarantee on the order of
-  // edges, nor on the order of (u, v) in each edge.
+  // Returns a view of all edges in the graph. There is no guarantee on the
+  // order of edges, nor on the order of (u, v) in each edge. The view is
+  // invalidated by any non-const call to the graph.
+  [[nodiscard]] std::span<const Edge> Edges() const { return edges_; }
+
+  // Returns a copy of all edges in the graph. Prefer Edges().
   std::vector<Edge> GetEdges() const;
 
   template <typename E, typename V>
@@ -94,14 +123,30 @@ class Graph {
   friend std::string PrettyPrintValue(const Graph& G, int max_len) {
     return std::format(
         "Graph(n={}, m={}, edges={})", G.NumNodes(), G.NumEdges(),
-        moriarty_internal::ValuePrinter(G.GetEdges(), max_len - 21));
+        moriarty_internal::ValuePrinter(G.Edges(), max_len - 21));
   }
 
  private:
+  // Edges incident to node i are edges[offsets[i]], ..., edges[offsets[i+1]-1].
+  // Built at most once. A graph and its copies share it until one of them
+  // changes.
+  struct Adjacency {
+    std::once_flag build_once;
+    std::atomic<bool> built = false;
+    std::vector<int64_t> offsets;
+    std::vector<Edge> edges;
+  };
+
   NodeIdx num_nodes_ = 0;
   std::vector<NodeLabel> node_labels_;
   std::unordered_map<NodeLabel, NodeIdx> node_label_to_index_;
   std::vector<Edge> edges_;
+  std::shared_ptr<Adjacency> adjacency_ = std::make_shared<Adjacency>();
+
+  const Adjacency& GetAdjacency() const;
+
+  // The adjacency of a graph with no nodes, shared by all moved-from graphs.
+  static std::shared_ptr<Adjacency> EmptyAdjacency();
 };
 
 // ----------------------------------------------------------------------------
@@ -115,14 +160,82 @@ Graph<E, V>::Graph(NodeIdx num_nodes) : num_nodes_(num_nodes) {
   node_labels_.resize(num_nodes_);
 }
 
+template <typename E, typename V>
+Graph<E, V>::Graph(Graph&& other) noexcept
+    : num_nodes_(std::exchange(other.num_nodes_, 0)),
+      node_labels_(std::move(other.node_labels_)),
+      node_label_to_index_(std::move(other.node_label_to_index_)),
+      edges_(std::move(other.edges_)),
+      adjacency_(std::exchange(other.adjacency_, EmptyAdjacency())) {
+  other.node_labels_.clear();
+  other.node_label_to_index_.clear();
+  other.edges_.clear();
+}
+
+template <typename E, typename V>
+Graph<E, V>& Graph<E, V>::operator=(Graph&& other) noexcept {
+  if (this == &other) return *this;
+  num_nodes_ = std::exchange(other.num_nodes_, 0);
+  node_labels_ = std::move(other.node_labels_);
+  node_label_to_index_ = std::move(other.node_label_to_index_);
+  edges_ = std::move(other.edges_);
+  adjacency_ = std::exchange(other.adjacency_, EmptyAdjacency());
+  other.node_labels_.clear();
+  other.node_label_to_index_.clear();
+  other.edges_.clear();
+  return *this;
+}
+
+template <typename E, typename V>
+auto Graph<E, V>::EmptyAdjacency() -> std::shared_ptr<Adjacency> {
+  static const std::shared_ptr<Adjacency> empty =
+      std::make_shared<Adjacency>();
+  return empty;
+}
+
+template <typename E, typename V>
+auto Graph<E, V>::GetAdjacency() const -> const Adjacency& {
+  Adjacency& adjacency = *adjacency_;
+  std::call_once(adjacency.build_once, [&] {
+    std::vector<int64_t>& offsets = adjacency.offsets;
+    offsets.assign(num_nodes_ + 1, 0);
+    for (const auto& [u, v, _] : edges_) {
+      offsets[u + 1]++;
+      if (u != v) offsets[v + 1]++;
+    }
+    for (NodeIdx i = 0; i < num_nodes_; i++) offsets[i + 1] += offsets[i];
+
+    std::vector<int64_t> next(offsets.begin(), offsets.end() - 1);
+    adjacency.edges.resize(offsets.back());
+    for (const auto& edge : edges_) {
+      adjacency.edges[next[edge.u]++] = edge;
+      if (edge.u != edge.v)
+        adjacency.edges[next[edge.v]++] = {edge.v, edge.u, edge.e};
+    }
+    adjacency.built.store(true, std::memory_order_release);
+  });
+  return adjacency;
+}
+
+template <typename E, typename V>
+auto Graph<E, V>::AdjacentEdges(NodeIdx node) const
+    -> std::span<const Graph::Edge> {
+  if (node < 0 || node >= num_nodes_) {
+    throw std::out_of_range("AdjacentEdges(): Node index out of range.");
+  }
+  const Adjacency& adjacency = GetAdjacency();
+  return std::span<const Edge>(adjacency.edges)
+      .subspan(adjacency.offsets[node],
+               adjacency.offsets[node + 1] - adjacency.offsets[node]);
+}
+
 template <typename E, typename V>
 auto Graph<E, V>::GetAdjacencyList() const
     -> std::vector<std::vector<Graph::Edge>> {
   std::vector<std::vector<Graph::Edge>> adjacency_list(num_nodes_);
-  for (const auto& edge : edges_) {
-    adjacency_list[edge.u].push_back(edge);
-    if (edge.u != edge.v)
-      adjacency_list[edge.v].push_back({edge.v, edge.u, edge.e});
+  for (NodeIdx i = 0; i < num_nodes_; i++) {
+    std::span<const Edge> adjacent = AdjacentEdges(i);
+    adjacency_list[i].assign(adjacent.begin(), adjacent.end());
   }
   return adjacency_list;
 }
@@ -137,10 +250,20 @@ Graph<E, V>& Graph<E, V>::AddEdge(int64_t u, int64_t v, E edge_label) {
   if (u < 0 || v < 0 || u >= num_nodes_ || v >= num_nodes_) {
     throw std::out_of_range("AddEdge(): Node index out of range.");
   }
+  // Copies of this graph may still be using the adjacency.
+  if (adjacency_.use_count() > 1 ||
+      adjacency_->built.load(std::memory_order_acquire)) {
+    adjacency_ = std::make_shared<Adjacency>();
+  }
   edges_.push_back({u, v, edge_label});
   return *this;
 }
 
+template <typename E, typename V>
+void Graph<E, V>::ReserveEdges(int64_t num_edges) {
+  edges_.reserve(num_edges);
+}
+
 template <typename E, typename V>
 void Graph<E, V>::SetNodeLabels(const std::vector<V>& node_labels) {
   if (node_labels.size() != num_nodes_) {
@@ -166,7 +289,7 @@ Graph<E, V>::NodeIdx Graph<E, V>::GetOrAddNodeIndex(const V& node_label) {
 }
 
 template <typename E, typename V>
-std::vector<V> Graph<E, V>::GetNodeLabels() const {
+const std::vector<V>& Graph<E, V>::GetNodeLabels() const {
   return node_labels_;
 }
 
@@ -14,7 +14,9 @@
 
 #include "moriarty/types/graph.h"
 
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -28,6 +30,7 @@ using testing::ElementsAre;
 using testing::Eq;
 using testing::IsEmpty;
 using testing::SizeIs;
+using testing::UnorderedElementsAre;
 
 TEST(GraphTest, ConstructorGivesEmptyGraph) {
   Graph graph(10);
@@ -70,5 +73,66 @@ TEST(GraphTest, AddingAnInvalidEdgeThrows) {
   EXPECT_THROW(graph.AddEdge(4, 2), std::out_of_range);
 }
 
+TEST(GraphTest, EdgesViewShowsAllEdges) {
+  Graph<int> graph(4);
+  graph.AddEdge(2, 3, 5).AddEdge(1, 1, 7);
+  EXPECT_THAT(graph.Edges(), ElementsAre(Graph<int>::Edge{2, 3, 5},
+                                         Graph<int>::Edge{1, 1, 7}));
+}
+
+TEST(GraphTest, AdjacentEdgesAreOrientedAwayFromTheNode) {
+  Graph<int> graph(4);
+  graph.AddEdge(2, 3, 5).AddEdge(1, 1, 7).AddEdge(0, 2, 9);
+  EXPECT_THAT(graph.AdjacentEdges(0), ElementsAre(Graph<int>::Edge{0, 2, 9}));
+  EXPECT_THAT(graph.AdjacentEdges(1), ElementsAre(Graph<int>::Edge{1, 1, 7}));
+  EXPECT_THAT(graph.AdjacentEdges(2),
+              UnorderedElementsAre(Graph<int>::Edge{2, 3, 5},
+                                   Graph<int>::Edge{2, 0, 9}));
+  EXPECT_THAT(graph.AdjacentEdges(3), ElementsAre(Graph<int>::Edge{3, 2, 5}));
+  EXPECT_THROW((void)graph.AdjacentEdges(4), std::out_of_range);
+}
+
+TEST(GraphTest, AdjacentEdgesSeeLaterEdgesButCopiesDoNot) {
+  Graph graph(3);
+  graph.AddEdge(0, 1);
+  EXPECT_THAT(graph.AdjacentEdges(0), SizeIs(1));
+
+  Graph copy = graph;
+  graph.AddEdge(0, 2);
+  EXPECT_THAT(graph.AdjacentEdges(0), SizeIs(2));
+  EXPECT_THAT(copy.AdjacentEdges(0), SizeIs(1));
+  EXPECT_THAT(copy.AdjacentEdges(2), IsEmpty());
+
+  copy.AddEdge(1, 2);
+  EXPECT_THAT(graph.AdjacentEdges(1), SizeIs(1));
+  EXPECT_THAT(copy.AdjacentEdges(1), SizeIs(2));
+}
+
+TEST(GraphTest, MovedFromGraphsShouldBeEmptyAndUsable) {
+  Graph graph(3);
+  graph.AddEdge(0, 1);
+  EXPECT_THAT(graph.AdjacentEdges(0), SizeIs(1));
+
+  Graph moved = std::move(graph);
+  EXPECT_THAT(moved.AdjacentEdges(0), SizeIs(1));
+  EXPECT_EQ(graph.NumNodes(), 0);
+  EXPECT_THAT(graph.Edges(), IsEmpty());
+  EXPECT_THAT(graph.GetAdjacencyList(), IsEmpty());
+  EXPECT_THROW(graph.AdjacentEdges(0), std::out_of_range);
+
+  Graph assigned(2);
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.NumNodes(), 3);
+  EXPECT_THAT(assigned.AdjacentEdges(1), SizeIs(1));
+  EXPECT_THAT(moved.GetAdjacencyList(), IsEmpty());
+  EXPECT_EQ(moved, graph);
+
+  // Both moved-from graphs can be reused.
+  graph = Graph(2);
+  graph.AddEdge(0, 1);
+  EXPECT_THAT(graph.AdjacentEdges(1), SizeIs(1));
+  EXPECT_THAT(moved.Edges(), IsEmpty());
+}
+
 }  // namespace
 }  // namespace moriarty
@@ -0,0 +1,147 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_TYPES_MATRIX_H_
+#define MORIARTY_TYPES_MATRIX_H_
+
+#include <cstdint>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "moriarty/internal/value_printer.h"
+
+namespace moriarty {
+
+// Matrix
+//
+// A 2-dimensional grid of values, stored row-by-row in a single contiguous
+// buffer. `T` must not be `bool` (since `std::vector<bool>` is not
+// contiguous).
+template <typename T>
+class Matrix {
+ public:
+  // Constructs an empty 0x0 matrix.
+  Matrix() = default;
+
+  // Constructs a `num_rows` x `num_cols` matrix with every entry set to
+  // `fill`.
+  explicit Matrix(int64_t num_rows, int64_t num_cols, const T& fill = T());
+
+  // Constructs a `num_rows` x `num_cols` matrix from its entries, given
+  // row-by-row. `entries` must contain exactly `num_rows * num_cols` values.
+  explicit Matrix(int64_t num_rows, int64_t num_cols,
+                  std::vector<T> entries);
+
+  // Constructs a matrix from its rows. All rows must have the same length.
+  // E.g., Matrix<int64_t>({{1, 2, 3}, {4, 5, 6}})
+  explicit Matrix(const std::vector<std::vector<T>>& rows);
+
+  // Returns the number of rows in the matrix.
+  [[nodiscard]] int64_t NumRows() const { return num_rows_; }
+
+  // Returns the number of columns in the matrix.
+  [[nodiscard]] int64_t NumCols() const { return num_cols_; }
+
+  // Returns the entry in row `r` and column `c` (both 0-based). No bounds
+  // checking is done.
+  [[nodiscard]] T& operator()(int64_t r, int64_t c) {
+    return entries_[r * num_cols_ + c];
+  }
+  [[nodiscard]] const T& operator()(int64_t r, int64_t c) const {
+    return entries_[r * num_cols_ + c];
+  }
+
+  // Returns a view of row `r` (0-based). No bounds checking is done.
+  [[nodiscard]] std::span<T> Row(int64_t r) {
+    return std::span<T>(entries_).subspan(r * num_cols_, num_cols_);
+  }
+  [[nodiscard]] std::span<const T> Row(int64_t r) const {
+    return std::span<const T>(entries_).subspan(r * num_cols_, num_cols_);
+  }
+
+  // Returns a view of all entries, row-by-row.
+  [[nodiscard]] std::span<T> Entries() { return entries_; }
+  [[nodiscard]] std::span<const T> Entries() const { return entries_; }
+
+  // Returns the matrix as a vector of rows.
+  [[nodiscard]] std::vector<std::vector<T>> ToRows() const;
+
+  bool operator==(const Matrix& other) const = default;
+
+  friend std::string PrettyPrintValue(const Matrix& M, int max_len) {
+    return std::format(
+        "Matrix(rows={}, cols={}, entries={})", M.NumRows(), M.NumCols(),
+        moriarty_internal::ValuePrinter(M.entries_, max_len - 32));
+  }
+
+ private:
+  int64_t num_rows_ = 0;
+  int64_t num_cols_ = 0;
+  std::vector<T> entries_;
+};
+
+// ----------------------------------------------------------------------------
+//  Template implementation below
+
+template <typename T>
+Matrix<T>::Matrix(int64_t num_rows, int64_t num_cols, const T& fill)
+    : num_rows_(num_rows), num_cols_(num_cols) {
+  if (num_rows < 0 || num_cols < 0) {
+    throw std::invalid_argument("Matrix(): dimensions must be non-negative.");
+  }
+  entries_.assign(num_rows * num_cols, fill);
+}
+
+template <typename T>
+Matrix<T>::Matrix(int64_t num_rows, int64_t num_cols, std::vector<T> entries)
+    : num_rows_(num_rows), num_cols_(num_cols), entries_(std::move(entries)) {
+  if (num_rows < 0 || num_cols < 0) {
+    throw std::invalid_argument("Matrix(): dimensions must be non-negative.");
+  }
+  if (entries_.size() != num_rows * num_cols) {
+    throw std::invalid_argument(
+        "Matrix(): number of entries does not match the dimensions.");
+  }
+}
+
+template <typename T>
+Matrix<T>::Matrix(const std::vector<std::vector<T>>& rows)
+    : num_rows_(rows.size()), num_cols_(rows.empty() ? 0 : rows[0].size()) {
+  entries_.reserve(num_rows_ * num_cols_);
+  for (const std::vector<T>& row : rows) {
+    if (row.size() != num_cols_) {
+      throw std::invalid_argument("Matrix(): all rows must have equal length.");
+    }
+    entries_.insert(entries_.end(), row.begin(), row.end());
+  }
+}
+
+template <typename T>
+std::vector<std::vector<T>> Matrix<T>::ToRows() const {
+  std::vector<std::vector<T>> rows;
+  rows.reserve(num_rows_);
+  for (int64_t r = 0; r < num_rows_; r++) {
+    std::span<const T> row = Row(r);
+    rows.emplace_back(row.begin(), row.end());
+  }
+  return rows;
+}
+
+}  // namespace moriarty
+
+#endif  // MORIARTY_TYPES_MATRIX_H_
@@ -0,0 +1,86 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/types/matrix.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace moriarty {
+namespace {
+
+using testing::AllOf;
+using testing::Each;
+using testing::ElementsAre;
+using testing::Eq;
+using testing::IsEmpty;
+using testing::SizeIs;
+
+TEST(MatrixTest, DefaultConstructorGivesEmptyMatrix) {
+  Matrix<int64_t> matrix;
+  EXPECT_EQ(matrix.NumRows(), 0);
+  EXPECT_EQ(matrix.NumCols(), 0);
+  EXPECT_THAT(matrix.Entries(), IsEmpty());
+}
+
+TEST(MatrixTest, FillConstructorSetsAllEntries) {
+  Matrix<std::string> matrix(2, 3, "x");
+  EXPECT_EQ(matrix.NumRows(), 2);
+  EXPECT_EQ(matrix.NumCols(), 3);
+  EXPECT_THAT(matrix.Entries(), AllOf(SizeIs(6), Each(Eq("x"))));
+}
+
+TEST(MatrixTest, EntriesAreStoredRowByRow) {
+  Matrix<int64_t> matrix(2, 3, {1, 2, 3, 4, 5, 6});
+  EXPECT_EQ(matrix(0, 0), 1);
+  EXPECT_EQ(matrix(0, 2), 3);
+  EXPECT_EQ(matrix(1, 0), 4);
+  EXPECT_THAT(matrix.Row(1), ElementsAre(4, 5, 6));
+  EXPECT_THAT(matrix.ToRows(), ElementsAre(ElementsAre(1, 2, 3),  //
+                                           ElementsAre(4, 5, 6)));
+}
+
+TEST(MatrixTest, EntriesCanBeModified) {
+  Matrix<int64_t> matrix(2, 2);
+  matrix(1, 0) = 5;
+  matrix.Row(0)[1] = 7;
+  EXPECT_THAT(matrix.Entries(), ElementsAre(0, 7, 5, 0));
+}
+
+TEST(MatrixTest, ConstructingFromRowsWorks) {
+  EXPECT_EQ(Matrix<int64_t>({{1, 2}, {3, 4}, {5, 6}}),
+            Matrix<int64_t>(3, 2, {1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(Matrix<int64_t>(std::vector<std::vector<int64_t>>{}),
+            Matrix<int64_t>());
+}
+
+TEST(MatrixTest, EqualityConsidersShape) {
+  EXPECT_NE(Matrix<int64_t>(2, 3, {1, 2, 3, 4, 5, 6}),
+            Matrix<int64_t>(3, 2, {1, 2, 3, 4, 5, 6}));
+  EXPECT_NE(Matrix<int64_t>(0, 3), Matrix<int64_t>(3, 0));
+}
+
+TEST(MatrixTest, InvalidShapesShouldThrow) {
+  EXPECT_THROW(Matrix<int64_t>(-1, 2), std::invalid_argument);
+  EXPECT_THROW(Matrix<int64_t>(2, 2, {1, 2, 3}), std::invalid_argument);
+  EXPECT_THROW(Matrix<int64_t>({{1, 2}, {3}}), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace moriarty
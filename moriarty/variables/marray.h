@@ -213,7 +213,8 @@ class MArray : public librarian::MVariable<MArray<MElementType>> {
       kLength = 1 << 1,
       kComparator = 1 << 2,
 
-      kDistinctElements = 1 << 4,  // Default: false
+      kDistinctElements = 1 << 4,   // Default: false
+      kDefaultComparator = 1 << 5,  // Default: false
     };
 
     struct Data {
@@ -222,6 +223,9 @@ class MArray : public librarian::MVariable<MArray<MElementType>> {
       MElementType elements;
       MInteger length;
       comparator_type comparator;
+      // Sorts using the comparator without type-erasing it (unlike
+      // `comparator`).
+      std::function<void(vector_value_type&)> sort;
     };
     librarian::CowPtr<Data> data_;
     bool IsSet(Flags flag) const;
@@ -356,6 +360,15 @@ MArray<T>& MArray<T>::AddConstraint(Sorted<T, Comp, Proj> constraint) {
   auto& constraints = core_constraints_.data_.Mutable();
   constraints.touched |= CoreConstraints::Flags::kComparator;
   constraints.comparator = constraint.GetComparator();
+  constraints.sort = [constraint](vector_value_type& values) {
+    constraint.Sort(values);
+  };
+  if constexpr (std::same_as<Comp, std::ranges::less> &&
+                std::same_as<Proj, std::identity>) {
+    constraints.touched |= CoreConstraints::Flags::kDefaultComparator;
+  } else {
+    constraints.touched &= ~CoreConstraints::Flags::kDefaultComparator;
+  }
   return this->InternalAddConstraint(std::move(constraint));
 }
 
@@ -406,6 +419,17 @@ auto MArray<MElementType>::GenerateImpl(
 
   int length = length_local.Generate(ctx.ForSubVariable("length"));
 
+  // Sorted integers can be generated in order directly, avoiding the sort.
+  if constexpr (std::same_as<MElementType, MInteger>) {
+    if (core_constraints_.IsSet(CoreConstraints::Flags::kDefaultComparator) &&
+        !core_constraints_.DistinctElements()) {
+      std::optional<std::vector<int64_t>> values =
+          core_constraints_.Elements().GenerateSortedValues(
+              ctx.ForSubVariable("elem"), length);
+      if (values) return *std::move(values);
+    }
+  }
+
   vector_value_type res;
   if (core_constraints_.DistinctElements()) {
     res = GenerateNDistinctImpl(ctx, length);
@@ -419,7 +443,7 @@ auto MArray<MElementType>::GenerateImpl(
   }
 
   if (core_constraints_.ComparatorConstrained())
-    std::ranges::sort(res, core_constraints_.Comparator());
+    core_constraints_.data_->sort(res);
 
   return res;
 }
@@ -427,6 +451,23 @@ auto MArray<MElementType>::GenerateImpl(
 template <typename MElementType>
 auto MArray<MElementType>::GenerateNDistinctImpl(
     librarian::GenerateVariableContext ctx, int n) const -> vector_value_type {
+  // Integers can be sampled without replacement directly, which avoids the
+  // coupon-collector behaviour of the rejection loop below.
+  if constexpr (std::same_as<MElementType, MInteger>) {
+    std::optional<std::vector<int64_t>> values =
+        core_constraints_.Elements().GenerateDistinctValues(
+            ctx.ForSubVariable("elem"), n);
+    if (values) {
+      if (values->size() < n) {
+        throw GenerationError(
+            ctx.GetLocalVariableName(),
+            "Cannot generate enough distinct values for array.",
+            RetryPolicy::kRetry);
+      }
+      return *std::move(values);
+    }
+  }
+
   vector_value_type res;
   res.reserve(n);
 
@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <numeric>
 #include <sstream>
 #include <unordered_set>
 #include <utility>
@@ -27,6 +29,7 @@
 #include "gtest/gtest.h"
 #include "moriarty/constraints/base_constraints.h"
 #include "moriarty/constraints/container_constraints.h"
+#include "moriarty/constraints/integer_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
 #include "moriarty/constraints/string_constraints.h"
 #include "moriarty/contexts/librarian_context.h"
@@ -56,6 +59,7 @@ using ::moriarty_testing::Write;
 using ::testing::AllOf;
 using ::testing::Each;
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Ge;
 using ::testing::IsEmpty;
 using ::testing::IsSupersetOf;
@@ -63,6 +67,7 @@ using ::testing::Le;
 using ::testing::Not;
 using ::testing::SizeIs;
 using ::testing::Throws;
+using ::testing::Truly;
 using ::testing::UnorderedElementsAre;
 
 TEST(MArrayTest, TypenameIsCorrect) {
@@ -333,6 +338,64 @@ TEST(MArrayTest, WithDistinctElementsIsAbleToGenerateWithHugeValue) {
               GeneratedValuesAre(SizeIs(500)));
 }
 
+TEST(MArrayTest, WithDistinctElementsCanGenerateAPermutationOfALargeRange) {
+  std::vector<int64_t> expected(10'000);
+  std::iota(expected.begin(), expected.end(), 1);
+
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, 10'000)), Length(10'000),
+                       DistinctElements()),
+      GeneratedValuesAre(AllOf(SizeIs(10'000), Not(HasDuplicateIntegers()),
+                               Each(AllOf(Ge(1), Le(10'000))))));
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, 10'000)), Length(10'000),
+                       DistinctElements(), Sorted<MInteger>()),
+      GeneratedValuesAre(ElementsAreArray(expected)));
+}
+
+TEST(MArrayTest, WithDistinctElementsFromAHugeRangeWorks) {
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(-1'000'000'000'000'000'000,
+                                                1'000'000'000'000'000'000)),
+                               Length(1000), DistinctElements()),
+              GeneratedValuesAre(
+                  AllOf(SizeIs(1000), Not(HasDuplicateIntegers()))));
+}
+
+TEST(MArrayTest, WithDistinctElementsRespectsModConstraints) {
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, 30), Mod(2, 3)), Length(10),
+                       DistinctElements()),
+      GeneratedValuesAre(UnorderedElementsAre(2, 5, 8, 11, 14, 17, 20, 23, 26,
+                                              29)));
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(1, 30), Mod(2, 3)), Length(11),
+                               DistinctElements()),
+              GenerateThrowsGenerationError("", Context()));
+}
+
+TEST(MArrayTest, WithDistinctElementsRespectsCustomElementConstraints) {
+  MInteger even = MInteger(Between(1, 20)).AddCustomConstraint(
+      "Even", [](int64_t x) { return x % 2 == 0; });
+
+  EXPECT_THAT(MArray<MInteger>(even)
+                  .AddConstraint(Length(10))
+                  .AddConstraint(DistinctElements()),
+              GeneratedValuesAre(
+                  UnorderedElementsAre(2, 4, 6, 8, 10, 12, 14, 16, 18, 20)));
+  EXPECT_THAT(MArray<MInteger>(even)
+                  .AddConstraint(Length(11))
+                  .AddConstraint(DistinctElements()),
+              GenerateThrowsGenerationError("", Context()));
+}
+
+TEST(MArrayTest, WithDistinctElementsDependingOnOtherVariablesWorks) {
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, "N")), Length("N"),
+                       DistinctElements()),
+      GeneratedValuesAre(
+          UnorderedElementsAre(1, 2, 3, 4, 5, 6),
+          Context().WithVariable("N", MInteger(Exactly(6)))));
+}
+
 TEST(MArrayTest, WhitespaceSeparatorShouldAffectWrite) {
   EXPECT_EQ(
       Write(MArray<MInteger>(MArrayFormat().NewlineSeparated()), {1, 2, 3}),
@@ -480,5 +543,71 @@ TEST(MArrayTest, SortedConstraintWorks) {
       GeneratedValuesAre(IsSorted()));
 }
 
+TEST(MArrayTest, SortedIntegersRespectElementConstraints) {
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, 100), Mod(1, 4)), Length(1000),
+                       Sorted<MInteger>()),
+      GeneratedValuesAre(AllOf(
+          SizeIs(1000), IsSorted(), Each(AllOf(Ge(1), Le(97))),
+          Each(Truly([](int64_t x) { return x % 4 == 1; })))));
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(5, 5)), Length(10),
+                               Sorted<MInteger>()),
+              GeneratedValuesAre(ElementsAre(5, 5, 5, 5, 5, 5, 5, 5, 5, 5)));
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(1, "N")), Length(100),
+                       Sorted<MInteger>()),
+      GeneratedValuesAre(AllOf(IsSorted(), Each(AllOf(Ge(1), Le(6)))),
+                         Context().WithVariable("N", MInteger(Exactly(6)))));
+}
+
+TEST(MArrayTest, SortedIntegersFromLargeRangesWork) {
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(1, 1'000'000'000)),
+                               Length(100'000), Sorted<MInteger>()),
+              GeneratedValuesAre(AllOf(SizeIs(100'000), IsSorted())));
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(-1'000'000'000'000'000'000,
+                                                1'000'000'000'000'000'000)),
+                               Length(1000), Sorted<MInteger>()),
+              GeneratedValuesAre(AllOf(SizeIs(1000), IsSorted())));
+}
+
+TEST(MArrayTest, IntegersFromTheFullInt64RangeWork) {
+  // Too many candidates to index, so these use independent draws instead.
+  auto any_int64 = [] {
+    return Elements(Between(std::numeric_limits<int64_t>::min(),
+                            std::numeric_limits<int64_t>::max()));
+  };
+  EXPECT_THAT(
+      MArray<MInteger>(any_int64(), Length(1000), DistinctElements()),
+      GeneratedValuesAre(AllOf(SizeIs(1000), Not(HasDuplicateIntegers()))));
+  EXPECT_THAT(
+      MArray<MInteger>(any_int64(), Length(1000), Sorted<MInteger>()),
+      GeneratedValuesAre(AllOf(SizeIs(1000), IsSorted())));
+}
+
+TEST(MArrayTest, SortedIntegersRespectCustomElementConstraints) {
+  MInteger even = MInteger(Between(1, 20)).AddCustomConstraint(
+      "Even", [](int64_t x) { return x % 2 == 0; });
+
+  EXPECT_THAT(
+      MArray<MInteger>(even)
+          .AddConstraint(Length(30))
+          .AddConstraint(Sorted<MInteger>()),
+      GeneratedValuesAre(AllOf(
+          SizeIs(30), IsSorted(),
+          Each(Truly([](int64_t x) { return x % 2 == 0; })))));
+}
+
+TEST(MArrayTest, SortedIntegersWithNonDefaultComparatorWork) {
+  EXPECT_THAT(MArray<MInteger>(Elements(Between(1, 1000)), Length(100),
+                               Sorted<MInteger, std::greater<>>()),
+              GeneratedValuesAre(IsSortedBy(std::greater<>{})));
+  EXPECT_THAT(
+      MArray<MInteger>(Elements(Between(-100, 100)), Length(100),
+                       Sorted<MInteger, std::ranges::less,
+                              decltype([](int64_t x) { return x * x; })>()),
+      GeneratedValuesAre(
+          IsSortedBy([](int64_t a, int64_t b) { return a * a < b * b; })));
+}
+
 }  // namespace
 }  // namespace moriarty
@@ -0,0 +1,544 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_VARIABLES_MCOLUMNS_H_
+#define MORIARTY_VARIABLES_MCOLUMNS_H_
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_join.h"
+#include "moriarty/constraints/constraint_violation.h"
+#include "moriarty/constraints/container_constraints.h"
+#include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/constraints/size_constraints.h"
+#include "moriarty/contexts/librarian_context.h"
+#include "moriarty/librarian/errors.h"
+#include "moriarty/librarian/io_config.h"
+#include "moriarty/librarian/mvariable.h"
+#include "moriarty/librarian/policies.h"
+#include "moriarty/librarian/util/cow_ptr.h"
+#include "moriarty/librarian/util/ref.h"
+#include "moriarty/types/columns.h"
+#include "moriarty/variables/minteger.h"
+#include "moriarty/variables/mtuple.h"
+
+namespace moriarty {
+
+template <typename... MElementTypes>
+class MColumns;
+namespace librarian {
+template <typename... MElementTypes>
+struct MVariableValueTypeTrait<MColumns<MElementTypes...>> {
+  using type = Columns<typename MElementTypes::value_type...>;
+};
+}  // namespace librarian
+
+// MColumns<>
+//
+// Describes constraints placed on a list of tuples, one tuple per line (e.g.,
+// an edge list or a list of queries). Logically equivalent to
+// `MArray<MTuple<MElementTypes...>>`, but the value is stored column-by-column
+// (see `Columns<T...>`), and constraints on each component are validated one
+// column at a time.
+//
+// In order to generate, the number of rows must be constrained (via the
+// `Length` constraint).
+template <typename... MElementTypes>
+class MColumns : public librarian::MVariable<MColumns<MElementTypes...>> {
+ public:
+  using columns_value_type = Columns<typename MElementTypes::value_type...>;
+  using tuple_value_type = std::tuple<typename MElementTypes::value_type...>;
+  class Reader;  // Forward declaration
+  using chunked_reader_type = Reader;
+
+  static_assert(
+      (MoriartyVariable<MElementTypes> && ...),
+      "MColumns<T1, T2> requires T1 and T2 to be MVariables (E.g., MInteger or "
+      "MString).");
+
+  // Create an MColumns from a set of constraints. Logically equivalent to
+  // calling AddConstraint() for each constraint.
+  //
+  // E.g.,
+  //     MColumns<MInteger, MInteger>(
+  //          Length(Between(1, 100)),
+  //          Element<0, MInteger>(Between(1, "N")),
+  //          Element<1, MInteger>(Between(1, "N")));
+  template <typename... Constraints>
+    requires(ConstraintFor<MColumns, Constraints> && ...)
+  explicit MColumns(Constraints&&... constraints);
+
+  // Create an MColumns by specifying the constraints on each column directly.
+  //
+  // E.g.,
+  //     MColumns(MInteger(Between(1, 10)), MString(Length(15)));
+  explicit MColumns(MElementTypes... column_constraints);
+
+  ~MColumns() override = default;
+
+  // Typename()
+  //
+  // Returns a string representing the name of this type (for example,
+  // "MColumns<MInteger, MInteger, MString>"). This is mostly used for
+  // debugging/error messages.
+  [[nodiscard]] std::string Typename() const override;
+
+  using librarian::MVariable<MColumns>::AddConstraint;  // Custom constraints
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the value to a specific set of values
+
+  // The list must have exactly this value.
+  MColumns& AddConstraint(Exactly<columns_value_type> constraint);
+  // The list must be one of these values.
+  MColumns& AddConstraint(OneOf<columns_value_type> constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the number of rows
+
+  // The list must have this many rows.
+  MColumns& AddConstraint(Length constraint);
+  // The list should have approximately this many rows.
+  MColumns& AddConstraint(SizeCategory constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain each column
+
+  // The I-th component of every row must satisfy these constraints.
+  template <size_t I, typename MElementType>
+  MColumns& AddConstraint(Element<I, MElementType> constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the I/O
+
+  // Change the format of each row. Rows are always separated by newlines.
+  MColumns& AddConstraint(MTupleFormat constraint);
+  // Returns the I/O format of each row.
+  [[nodiscard]] MTupleFormat& Format();
+  // Returns the I/O format of each row.
+  [[nodiscard]] MTupleFormat Format() const;
+
+  // MColumns::Reader
+  //
+  // Reads the list one row at a time, without reading the newlines between
+  // rows. Call ReadNext() once per row, then call Finalize() to get the final
+  // value, which will leave this in a moved-from-state.
+  class Reader {
+   public:
+    explicit Reader(librarian::ReadVariableContext ctx, int num_chunks,
+                    Ref<const MColumns> variable);
+    void ReadNext(librarian::ReadVariableContext ctx);
+    columns_value_type Finalize() &&;
+
+   private:
+    std::tuple<std::vector<typename MElementTypes::value_type>...> columns_;
+    Ref<const MColumns> variable_;
+  };
+
+  // MColumns::CoreConstraints
+  //
+  // A base set of constraints for `MColumns` that are used during generation.
+  // Note: Returned references are invalidated after any non-const call to this
+  // class or the corresponding `MColumns`.
+  class CoreConstraints {
+   public:
+    bool ElementsConstrained() const;
+    const std::tuple<MElementTypes...>& Elements() const;
+
+    bool LengthConstrained() const;
+    const MInteger& Length() const;
+
+   private:
+    friend class MColumns;
+    enum Flags : uint32_t {
+      kElements = 1 << 0,
+      kLength = 1 << 1,
+    };
+    struct Data {
+      std::underlying_type_t<Flags> touched = 0;
+      std::tuple<MElementTypes...> elements;
+      MInteger length;
+    };
+    librarian::CowPtr<Data> data_;
+    bool IsSet(Flags flag) const;
+  };
+  [[nodiscard]] CoreConstraints GetCoreConstraints() const {
+    return core_constraints_;
+  }
+
+ private:
+  CoreConstraints core_constraints_;
+  MTupleFormat format_;
+
+  // Whether every component is an integer. Such rows are written without
+  // going through each component's MVariable.
+  static constexpr bool kAllIntegers = (std::same_as<MElementTypes, MInteger> &&
+                                        ...);
+
+  // Reads one row, appending each component to its column. If
+  // `validate_integers` is false, integer components are not validated, and
+  // the caller must validate the whole column afterwards.
+  void ReadRow(librarian::ReadVariableContext ctx,
+               std::tuple<std::vector<typename MElementTypes::value_type>...>&
+                   columns,
+               bool validate_integers) const;
+
+  // Writes row `idx` of `value`.
+  void WriteRow(librarian::WriteVariableContext ctx,
+                const columns_value_type& value, size_t idx) const;
+
+  // ---------------------------------------------------------------------------
+  //  MVariable overrides
+  columns_value_type GenerateImpl(
+      librarian::GenerateVariableContext ctx) const override;
+  columns_value_type ReadImpl(
+      librarian::ReadVariableContext ctx) const override;
+  void WriteImpl(librarian::WriteVariableContext ctx,
+                 const columns_value_type& value) const override;
+  // ---------------------------------------------------------------------------
+
+  // Validates the I-th column as a whole (see `StronglyTypedElements`).
+  template <size_t I, typename MElementType>
+  struct ColumnConstraintWrapper {
+   public:
+    explicit ColumnConstraintWrapper(Element<I, MElementType> constraint);
+    ValidationResult Validate(ConstraintContext ctx,
+                              const columns_value_type& value) const;
+    std::string ToString() const;
+    Dependencies GetDependencies() const;
+    void ApplyTo(MColumns& other) const;
+
+   private:
+    Element<I, MElementType> constraint_;
+    StronglyTypedElements<MElementType> column_constraints_;
+  };
+};
+
+// Class template argument deduction (CTAD). Allows for `MColumns(MInteger(),
+// MString())` instead of `MColumns<MInteger, MString>()`.
+template <typename... MElementTypes>
+MColumns(MElementTypes...) -> MColumns<MElementTypes...>;
+
+// -----------------------------------------------------------------------------
+//  Template Implementation Below
+
+template <typename... T>
+MColumns<T...>::MColumns(T... column_constraints) {
+  auto apply_one = [&]<std::size_t I>() {
+    this->AddConstraint(
+        Element<I, typename std::tuple_element_t<I, std::tuple<T...>>>(
+            std::get<I>(std::tuple{column_constraints...})));
+  };
+
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (apply_one.template operator()<I>(), ...);
+  }(std::index_sequence_for<T...>{});
+}
+
+template <typename... T>
+template <typename... Constraints>
+  requires(ConstraintFor<MColumns<T...>, Constraints> && ...)
+MColumns<T...>::MColumns(Constraints&&... constraints) {
+  (AddConstraint(std::forward<Constraints>(constraints)), ...);
+}
+
+template <typename... T>
+std::string MColumns<T...>::Typename() const {
+  std::tuple typenames = std::apply(
+      [](auto&&... elem) { return std::make_tuple(elem.Typename()...); },
+      core_constraints_.Elements());
+  return std::format("MColumns<{}>", absl::StrJoin(typenames, ", "));
+}
+
+template <typename... T>
+MColumns<T...>& MColumns<T...>::AddConstraint(
+    Exactly<columns_value_type> constraint) {
+  return this->InternalAddExactlyConstraint(std::move(constraint));
+}
+
+template <typename... T>
+MColumns<T...>& MColumns<T...>::AddConstraint(
+    OneOf<columns_value_type> constraint) {
+  return this->InternalAddOneOfConstraint(std::move(constraint));
+}
+
+template <typename... T>
+MColumns<T...>& MColumns<T...>::AddConstraint(Length constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kLength;
+  constraints.length.MergeFrom(constraint.GetConstraints());
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename... T>
+MColumns<T...>& MColumns<T...>::AddConstraint(SizeCategory constraint) {
+  return AddConstraint(Length(constraint));
+}
+
+template <typename... T>
+template <size_t I, typename MElementType>
+MColumns<T...>& MColumns<T...>::AddConstraint(
+    Element<I, MElementType> constraint) {
+  static_assert(
+      std::same_as<MElementType,
+                   typename std::tuple_element_t<I, std::tuple<T...>>>,
+      "Column I does not match the type passed in the constraint");
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kElements;
+
+  std::get<I>(constraints.elements).MergeFrom(constraint.GetConstraints());
+  return this->InternalAddConstraint(
+      ColumnConstraintWrapper(std::move(constraint)));
+}
+
+template <typename... T>
+MColumns<T...>& MColumns<T...>::AddConstraint(MTupleFormat constraint) {
+  Format().Merge(constraint);
+  return *this;
+}
+
+template <typename... T>
+MTupleFormat& MColumns<T...>::Format() {
+  return format_;
+}
+
+template <typename... T>
+MTupleFormat MColumns<T...>::Format() const {
+  return format_;
+}
+
+template <typename... T>
+auto MColumns<T...>::GenerateImpl(librarian::GenerateVariableContext ctx) const
+    -> columns_value_type {
+  if (this->GetOneOf().HasBeenConstrained())
+    return this->GetOneOf().SelectOneOf(
+        [&](int n) { return ctx.RandomInteger(n); });
+
+  if (!core_constraints_.LengthConstrained()) {
+    throw GenerationError(ctx.GetLocalVariableName(),
+                          "Attempting to generate a list of rows with no "
+                          "length parameter given.",
+                          RetryPolicy::kAbort);
+  }
+
+  MInteger length_local = core_constraints_.Length();
+  length_local.AddConstraint(AtLeast(0));
+  int length = length_local.Generate(ctx.ForSubVariable("length"));
+
+  auto generate_column = [&]<std::size_t I>() {
+    const auto& element = std::get<I>(core_constraints_.Elements());
+    auto elem_name = [](int idx) {
+      return std::format("elem[{}]<{}>", idx, I);
+    };
+
+    std::vector<typename std::tuple_element_t<I, std::tuple<T...>>::value_type>
+        column;
+    column.reserve(length);
+    for (int i = 0; i < length; i++)
+      column.push_back(
+          element.Generate(ctx.ForIndexedSubVariable(elem_name, i)));
+    return column;
+  };
+
+  // Braced initialization guarantees the columns are generated in order.
+  return [&]<size_t... I>(std::index_sequence<I...>) {
+    return columns_value_type{generate_column.template operator()<I>()...};
+  }(std::index_sequence_for<T...>{});
+}
+
+template <typename... T>
+void MColumns<T...>::ReadRow(
+    librarian::ReadVariableContext ctx,
+    std::tuple<std::vector<typename T::value_type>...>& columns,
+    bool validate_integers) const {
+  auto read_one = [&]<std::size_t I>() {
+    if (I > 0) ctx.ReadWhitespace(Format().GetSeparator());
+    using MElementType = std::tuple_element_t<I, std::tuple<T...>>;
+    if constexpr (std::same_as<MElementType, MInteger>) {
+      if (!validate_integers) {
+        std::get<I>(columns).push_back(ctx.ReadInteger());
+        return;
+      }
+    }
+    std::get<I>(columns).push_back(
+        std::get<I>(core_constraints_.Elements()).Read(ctx));
+  };
+
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (read_one.template operator()<I>(), ...);
+  }(std::index_sequence_for<T...>{});
+}
+
+template <typename... T>
+auto MColumns<T...>::ReadImpl(librarian::ReadVariableContext ctx) const
+    -> columns_value_type {
+  std::optional<int64_t> length =
+      core_constraints_.Length().GetUniqueValue(ctx);
+  if (!length)
+    ctx.ThrowIOError("Cannot determine the number of rows before read.");
+
+  std::tuple<std::vector<typename T::value_type>...> columns;
+  std::apply([&](auto&... column) { (column.reserve(*length), ...); },
+             columns);
+  for (int64_t i = 0; i < *length; i++) {
+    if (i > 0) ctx.ReadWhitespace(Whitespace::kNewline);
+    ReadRow(ctx, columns, /*validate_integers=*/false);
+  }
+  // The columns are validated by `Read()` once the whole value is known.
+  return std::make_from_tuple<columns_value_type>(std::move(columns));
+}
+
+template <typename... T>
+void MColumns<T...>::WriteRow(librarian::WriteVariableContext ctx,
+                              const columns_value_type& value,
+                              size_t idx) const {
+  if constexpr (kAllIntegers) {
+    // Format the whole row at once instead of one token at a time.
+    char separator = WhitespaceAsChar(Format().GetSeparator());
+    std::string line;
+    char buffer[24];
+    auto append_one = [&]<std::size_t I>() {
+      if (I > 0) line.push_back(separator);
+      auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer),
+                                     value.template Column<I>()[idx]);
+      line.append(buffer, end);
+    };
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (append_one.template operator()<I>(), ...);
+    }(std::index_sequence_for<T...>{});
+    ctx.WriteToken(line);
+  } else {
+    auto write_one = [&]<std::size_t I>() {
+      if (I > 0) ctx.WriteWhitespace(Format().GetSeparator());
+      std::get<I>(core_constraints_.Elements())
+          .Write(ctx, value.template Column<I>()[idx]);
+    };
+    [&]<size_t... I>(std::index_sequence<I...>) {
+      (write_one.template operator()<I>(), ...);
+    }(std::index_sequence_for<T...>{});
+  }
+}
+
+template <typename... T>
+void MColumns<T...>::WriteImpl(librarian::WriteVariableContext ctx,
+                               const columns_value_type& value) const {
+  for (size_t i = 0; i < value.size(); i++) {
+    if (i > 0) ctx.WriteWhitespace(Whitespace::kNewline);
+    WriteRow(ctx, value, i);
+  }
+}
+
+// ====== MColumns::ColumnConstraintWrapper ======
+template <typename... T>
+template <size_t I, typename MElementType>
+MColumns<T...>::ColumnConstraintWrapper<I, MElementType>::
+    ColumnConstraintWrapper(Element<I, MElementType> constraint)
+    : constraint_(std::move(constraint)),
+      column_constraints_(constraint_.GetConstraints()) {}
+
+template <typename... T>
+template <size_t I, typename MElementType>
+ValidationResult
+MColumns<T...>::ColumnConstraintWrapper<I, MElementType>::Validate(
+    ConstraintContext ctx, const columns_value_type& value) const {
+  auto column_name = [](int idx) { return std::format("column {}", idx); };
+  auto v = column_constraints_.Validate(
+      ctx.ForIndexedSubVariable(column_name, I), value.template Column<I>());
+  if (v.IsOk()) return ValidationResult::Ok();
+  return ctx.Violation(value, std::move(v));
+}
+
+template <typename... T>
+template <size_t I, typename MElementType>
+std::string
+MColumns<T...>::ColumnConstraintWrapper<I, MElementType>::ToString() const {
+  return constraint_.ToString();
+}
+
+template <typename... T>
+template <size_t I, typename MElementType>
+Dependencies MColumns<T...>::ColumnConstraintWrapper<
+    I, MElementType>::GetDependencies() const {
+  return constraint_.GetDependencies();
+}
+
+template <typename... T>
+template <size_t I, typename MElementType>
+void MColumns<T...>::ColumnConstraintWrapper<I, MElementType>::ApplyTo(
+    MColumns& other) const {
+  other.AddConstraint(constraint_);
+}
+
+// ====== MColumns::Reader ======
+template <typename... MElementTypes>
+MColumns<MElementTypes...>::Reader::Reader(librarian::ReadVariableContext ctx,
+                                           int num_chunks,
+                                           Ref<const MColumns> variable)
+    : variable_(variable) {
+  std::apply([&](auto&... column) { (column.reserve(num_chunks), ...); },
+             columns_);
+}
+
+template <typename... MElementTypes>
+void MColumns<MElementTypes...>::Reader::ReadNext(
+    librarian::ReadVariableContext ctx) {
+  variable_.get().ReadRow(ctx, columns_, /*validate_integers=*/true);
+}
+
+template <typename... MElementTypes>
+auto MColumns<MElementTypes...>::Reader::Finalize() && -> columns_value_type {
+  return std::make_from_tuple<columns_value_type>(std::move(columns_));
+}
+
+// ====== MColumns::CoreConstraints ======
+template <typename... MElementTypes>
+const std::tuple<MElementTypes...>&
+MColumns<MElementTypes...>::CoreConstraints::Elements() const {
+  return data_->elements;
+}
+
+template <typename... MElementTypes>
+bool MColumns<MElementTypes...>::CoreConstraints::ElementsConstrained() const {
+  return IsSet(Flags::kElements);
+}
+
+template <typename... MElementTypes>
+const MInteger& MColumns<MElementTypes...>::CoreConstraints::Length() const {
+  return data_->length;
+}
+
+template <typename... MElementTypes>
+bool MColumns<MElementTypes...>::CoreConstraints::LengthConstrained() const {
+  return IsSet(Flags::kLength);
+}
+
+template <typename... MElementTypes>
+bool MColumns<MElementTypes...>::CoreConstraints::IsSet(Flags flag) const {
+  return (data_->touched & static_cast<std::underlying_type_t<Flags>>(flag)) !=
+         0;
+}
+
+}  // namespace moriarty
+
+#endif  // MORIARTY_VARIABLES_MCOLUMNS_H_
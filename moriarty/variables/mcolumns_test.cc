@@ -0,0 +1,225 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/variables/mcolumns.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "moriarty/constraints/container_constraints.h"
+#include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/constraints/integer_constraints.h"
+#include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/constraints/string_constraints.h"
+#include "moriarty/context.h"
+#include "moriarty/contexts/librarian_context.h"
+#include "moriarty/librarian/errors.h"
+#include "moriarty/librarian/io_config.h"
+#include "moriarty/librarian/testing/gtest_helpers.h"
+#include "moriarty/simple_io.h"
+#include "moriarty/test_case.h"
+#include "moriarty/types/columns.h"
+#include "moriarty/variables/marray.h"
+#include "moriarty/variables/minteger.h"
+#include "moriarty/variables/mstring.h"
+#include "moriarty/variables/mtuple.h"
+
+namespace moriarty {
+namespace {
+
+using ::moriarty_testing::Context;
+using ::moriarty_testing::GeneratedValuesAre;
+using ::moriarty_testing::GenerateThrowsGenerationError;
+using ::moriarty_testing::IsNotSatisfiedWith;
+using ::moriarty_testing::IsSatisfiedWith;
+using ::moriarty_testing::Read;
+using ::moriarty_testing::Write;
+using ::testing::AllOf;
+using ::testing::Each;
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::SizeIs;
+
+using EdgeList = Columns<int64_t, int64_t, int64_t>;
+
+MATCHER_P(ColumnIs, matcher, "") {
+  return ::testing::ExplainMatchResult(matcher, arg.template Column<0>(),
+                                       result_listener);
+}
+
+EdgeList Edges1() { return EdgeList({1, 2, 3}, {2, 3, 1}, {10, 20, 30}); }
+
+TEST(MColumnsTest, TypenameIsCorrect) {
+  EXPECT_EQ(MColumns(MInteger(), MString()).Typename(),
+            "MColumns<MInteger, MString>");
+}
+
+TEST(MColumnsTest, WriteShouldSucceed) {
+  EXPECT_EQ(Write(MColumns(MInteger(), MInteger(), MInteger()), Edges1()),
+            "1 2 10\n2 3 20\n3 1 30");
+  EXPECT_EQ(Write(MColumns(MInteger(), MString()),
+                  Columns<int64_t, std::string>({1, -2}, {"a", "bc"})),
+            "1 a\n-2 bc");
+  EXPECT_EQ(Write(MColumns(MInteger(), MInteger()),
+                  Columns<int64_t, int64_t>()),
+            "");
+}
+
+TEST(MColumnsTest, WriteWithSeparatorShouldSucceed) {
+  EXPECT_EQ(Write(MColumns(MInteger(), MInteger(), MInteger())
+                      .AddConstraint(MTupleFormat().WithSeparator(
+                          Whitespace::kTab)),
+                  Edges1()),
+            "1\t2\t10\n2\t3\t20\n3\t1\t30");
+}
+
+TEST(MColumnsTest, ReadShouldSucceed) {
+  EXPECT_EQ(Read(MColumns(MInteger(), MInteger(), MInteger())
+                     .AddConstraint(Length(3)),
+                 "1 2 10\n2 3 20\n3 1 30"),
+            Edges1());
+  EXPECT_EQ(Read(MColumns(MInteger(), MString()).AddConstraint(Length(2)),
+                 "1 a\n-2 bc"),
+            (Columns<int64_t, std::string>({1, -2}, {"a", "bc"})));
+}
+
+TEST(MColumnsTest, ReadWithUnknownLengthShouldFail) {
+  EXPECT_THROW((void)Read(MColumns(MInteger(), MInteger()), "1 2"), IOError);
+}
+
+TEST(MColumnsTest, ReadShouldValidateEachColumn) {
+  MColumns edges(MInteger(Between(1, 3)), MInteger(Between(1, 3)),
+                 MInteger(Between(1, 25)));
+  edges.AddConstraint(Length(3));
+  EXPECT_THROW((void)Read(edges, "1 2 10\n2 3 20\n3 1 30"), IOError);
+  EXPECT_THROW((void)Read(edges, "1 2 10\n2 4 20\n3 1 3"), IOError);
+  EXPECT_EQ(Read(edges, "1 2 10\n2 3 20\n3 1 3"),
+            EdgeList({1, 2, 3}, {2, 3, 1}, {10, 20, 3}));
+}
+
+TEST(MColumnsTest, PartialReadShouldSucceed) {
+  MColumns<MInteger, MInteger, MInteger> edges;
+
+  Context context;
+  std::istringstream input("1 2 10\n2 3 20\n3 1 30\n");
+  InputCursor cursor(input, WhitespaceStrictness::kPrecise);
+  librarian::ReadVariableContext ctx("A", cursor, context.Variables(),
+                                     context.Values());
+  auto reader = MColumns<MInteger, MInteger, MInteger>::Reader(ctx, 3, edges);
+
+  for (int i = 0; i < 3; i++) {
+    reader.ReadNext(ctx);
+    ASSERT_EQ(input.get(), '\n');  // Consume the separator
+  }
+  EXPECT_EQ(std::move(reader).Finalize(), Edges1());
+}
+
+TEST(MColumnsTest, PartialReadShouldValidateEachElement) {
+  MColumns edges(MInteger(Between(1, 3)), MInteger(), MInteger());
+
+  Context context;
+  std::istringstream input("4 2 10\n");
+  InputCursor cursor(input, WhitespaceStrictness::kPrecise);
+  librarian::ReadVariableContext ctx("A", cursor, context.Variables(),
+                                     context.Values());
+  auto reader = MColumns<MInteger, MInteger, MInteger>::Reader(ctx, 1, edges);
+  EXPECT_THROW(reader.ReadNext(ctx), IOError);
+}
+
+TEST(MColumnsTest, SimpleIOMultilineSectionShouldRead) {
+  Context context =
+      Context()
+          .WithVariable("N", MInteger())
+          .WithVariable("E", MColumns(MInteger(), MInteger(), MInteger()))
+          .WithVariable("X", MArray<MInteger>());
+
+  std::stringstream ss("3\n1 2 10 7\n2 3 20 8\n3 1 30 9\n");
+  InputCursor cursor(ss, WhitespaceStrictness::kPrecise);
+  ReadContext ctx(context.Variables(), cursor);
+  ReaderFn reader =
+      SimpleIO().AddLine("N").AddMultilineSection("N", "E", "X").Reader();
+
+  std::vector<TestCase> test_cases = reader(ctx);
+  ASSERT_EQ(test_cases.size(), 1);
+  EXPECT_EQ(
+      (test_cases[0].GetValue<MColumns<MInteger, MInteger, MInteger>>("E")),
+      Edges1());
+}
+
+TEST(MColumnsTest, GenerateShouldRespectLength) {
+  EXPECT_THAT(MColumns(MInteger(), MString(Length(1), Alphabet("ab")))
+                  .AddConstraint(Length(7)),
+              GeneratedValuesAre(SizeIs(7)));
+  EXPECT_THAT(MColumns(MInteger(), MInteger()).AddConstraint(Length(0)),
+              GeneratedValuesAre(SizeIs(0)));
+  EXPECT_THAT(MColumns(MInteger(), MInteger()).AddConstraint(Length("N")),
+              GeneratedValuesAre(SizeIs(5), Context().WithValue<MInteger>(
+                                                "N", 5)));
+}
+
+TEST(MColumnsTest, GenerateShouldRespectEachColumn) {
+  EXPECT_THAT(MColumns(MInteger(Between(1, 3)), MInteger(Between(50, 60)))
+                  .AddConstraint(Length(50)),
+              GeneratedValuesAre(AllOf(
+                  ColumnIs(Each(AllOf(Ge(1), Le(3)))),
+                  ::testing::Truly([](const Columns<int64_t, int64_t>& c) {
+                    for (const auto& [a, b] : c.Rows()) {
+                      if (b < 50 || b > 60) return false;
+                    }
+                    return true;
+                  }))));
+}
+
+TEST(MColumnsTest, GenerateWithoutLengthShouldFail) {
+  EXPECT_THAT(MColumns(MInteger(), MInteger()),
+              GenerateThrowsGenerationError("", Context()));
+}
+
+TEST(MColumnsTest, IsSatisfiedWithChecksLength) {
+  EXPECT_THAT(
+      MColumns(MInteger(), MInteger(), MInteger()).AddConstraint(Length(3)),
+      IsSatisfiedWith(Edges1()));
+  EXPECT_THAT(
+      MColumns(MInteger(), MInteger(), MInteger()).AddConstraint(Length(4)),
+      IsNotSatisfiedWith(Edges1(), "length"));
+}
+
+TEST(MColumnsTest, IsSatisfiedWithChecksEachColumn) {
+  EXPECT_THAT(MColumns(MInteger(Between(1, 3)), MInteger(Between(1, 3)),
+                       MInteger(Between(10, 30))),
+              IsSatisfiedWith(Edges1()));
+  EXPECT_THAT(MColumns(MInteger(Between(1, 3)), MInteger(Between(1, 2)),
+                       MInteger()),
+              IsNotSatisfiedWith(Edges1(), "index 1"));
+  EXPECT_THAT((MColumns<MInteger, MInteger, MInteger>(
+                  Element<2, MInteger>(Mod(0, 20)))),
+              IsNotSatisfiedWith(Edges1(), "column 2"));
+}
+
+TEST(MColumnsTest, IsSatisfiedWithChecksCustomColumnConstraints) {
+  MInteger not_two = MInteger().AddCustomConstraint(
+      "NotTwo", [](int64_t x) { return x != 2; });
+
+  EXPECT_THAT(MColumns(not_two, MInteger(), MInteger()),
+              IsNotSatisfiedWith(Edges1(), "index 1"));
+  EXPECT_THAT(MColumns(MInteger(), MInteger(), not_two),
+              IsSatisfiedWith(Edges1()));
+}
+
+}  // namespace
+}  // namespace moriarty
@@ -14,6 +14,20 @@
 
 #include "moriarty/variables/mgraph.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "moriarty/constraints/graph_constraints.h"
+#include "moriarty/contexts/librarian_context.h"
+
 namespace moriarty {
 
 MGraphFormat& MGraphFormat::EdgeList() { return SetStyle(Style::kEdgeList); }
@@ -25,7 +39,16 @@ MGraphFormat& MGraphFormat::AdjacencyMatrix() {
 }
 
 bool MGraphFormat::IsAdjacencyMatrix() const {
-  return style_ == Style::kAdjacencyMatrix;
+  return style_ == Style::kAdjacencyMatrix ||
+         style_ == Style::kBinaryAdjacencyMatrix;
+}
+
+MGraphFormat& MGraphFormat::BinaryAdjacencyMatrix() {
+  return SetStyle(Style::kBinaryAdjacencyMatrix);
+}
+
+bool MGraphFormat::IsBinaryAdjacencyMatrix() const {
+  return style_ == Style::kBinaryAdjacencyMatrix;
 }
 
 MGraphFormat& MGraphFormat::ZeroBased() {
@@ -71,4 +94,300 @@ void MGraphFormat::Merge(const MGraphFormat& other) {
   }
 }
 
+namespace moriarty_internal {
+
+int64_t NumNodePairs(int64_t num_nodes, bool with_loops) {
+  return with_loops ? num_nodes * (num_nodes + 1) / 2
+                    : num_nodes * (num_nodes - 1) / 2;
+}
+
+int64_t NodePairIndex(int64_t u, int64_t v, bool with_loops) {
+  return NumNodePairs(v, with_loops) + u;
+}
+
+std::pair<int64_t, int64_t> NodePairFromIndex(int64_t index,
+                                              bool with_loops) {
+  // Find the largest v with v * (v + 1) / 2 <= index. The floating point
+  // estimate may be off by one for large indices.
+  int64_t v = (std::sqrt(8.0 * static_cast<double>(index) + 1) - 1) / 2;
+  while (v > 0 && v * (v + 1) / 2 > index) v--;
+  while ((v + 1) * (v + 2) / 2 <= index) v++;
+  int64_t u = index - v * (v + 1) / 2;
+  return {u, with_loops ? v : v + 1};
+}
+
+std::vector<int64_t> RandomDistinctIndices(
+    librarian::GenerateVariableContext ctx, int64_t num_indices, int64_t k,
+    std::span<const int64_t> excluded) {
+  int64_t num_available = num_indices - static_cast<int64_t>(excluded.size());
+  if (k < 0 || k > num_available) {
+    throw std::invalid_argument(std::format(
+        "RandomDistinctIndices(): cannot choose {} of {} indices.", k,
+        num_available));
+  }
+
+  std::vector<int64_t> indices;
+  indices.reserve(k);
+  if (2 * k <= num_available) {
+    // Sparse: each probe finds an unused index with probability at least 1/2.
+    std::unordered_set<int64_t> used(excluded.begin(), excluded.end());
+    used.reserve(k + excluded.size());
+    while (static_cast<int64_t>(indices.size()) < k) {
+      int64_t index = ctx.RandomInteger(num_indices);
+      if (used.insert(index).second) indices.push_back(index);
+    }
+    return indices;
+  }
+
+  // Dense: choose the (fewer) indices to leave out instead, then take every
+  // index that remains.
+  std::vector<bool> unavailable(num_indices);
+  for (int64_t index : excluded) unavailable[index] = true;
+  for (int64_t left_out = 0; left_out < num_available - k;) {
+    int64_t index = ctx.RandomInteger(num_indices);
+    if (unavailable[index]) continue;
+    unavailable[index] = true;
+    left_out++;
+  }
+  for (int64_t index = 0; index < num_indices; index++) {
+    if (!unavailable[index]) indices.push_back(index);
+  }
+  ctx.Shuffle(indices);
+  return indices;
+}
+
+namespace {
+
+// Swaps the endpoints of each edge with probability 1/2.
+void RandomlyOrient(librarian::GenerateVariableContext ctx,
+                    std::vector<std::pair<int64_t, int64_t>>& edges) {
+  for (auto& [u, v] : edges) {
+    if (u != v && ctx.RandomInteger(2) == 1) std::swap(u, v);
+  }
+}
+
+// Returns 0, 1, ..., n - 1 in random order.
+std::vector<int64_t> RandomOrder(librarian::GenerateVariableContext ctx,
+                                 int64_t n) {
+  std::vector<int64_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  ctx.Shuffle(order);
+  return order;
+}
+
+// Returns the edges of a uniformly random labelled tree, decoded from a
+// random Prüfer sequence in linear time.
+std::vector<std::pair<int64_t, int64_t>> RandomPruferTreeEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes) {
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  if (num_nodes <= 1) return edges;
+  edges.reserve(num_nodes - 1);
+
+  std::vector<int64_t> sequence(num_nodes - 2);
+  std::vector<int64_t> degree(num_nodes, 1);
+  for (int64_t& x : sequence) {
+    x = ctx.RandomInteger(num_nodes);
+    degree[x]++;
+  }
+
+  // Repeatedly remove the smallest leaf. Removing a leaf can only create one
+  // new leaf (its neighbour `x`), so `ptr` only needs to scan forwards.
+  int64_t ptr = 0;
+  while (degree[ptr] != 1) ptr++;
+  int64_t leaf = ptr;
+  for (int64_t x : sequence) {
+    edges.emplace_back(leaf, x);
+    if (--degree[x] == 1 && x < ptr) {
+      leaf = x;
+    } else {
+      ptr++;
+      while (degree[ptr] != 1) ptr++;
+      leaf = ptr;
+    }
+  }
+  edges.emplace_back(leaf, num_nodes - 1);
+  return edges;
+}
+
+}  // namespace
+
+std::vector<std::pair<int64_t, int64_t>> RandomDistinctNodePairs(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes, int64_t k,
+    bool with_loops, std::span<const std::pair<int64_t, int64_t>> excluded) {
+  std::vector<int64_t> excluded_indices;
+  excluded_indices.reserve(excluded.size());
+  for (const auto& edge : excluded) {
+    auto [u, v] = std::minmax(edge.first, edge.second);
+    excluded_indices.push_back(NodePairIndex(u, v, with_loops));
+  }
+
+  std::vector<std::pair<int64_t, int64_t>> pairs;
+  pairs.reserve(k);
+  for (int64_t index :
+       RandomDistinctIndices(ctx, NumNodePairs(num_nodes, with_loops), k,
+                             excluded_indices)) {
+    pairs.push_back(NodePairFromIndex(index, with_loops));
+  }
+  RandomlyOrient(ctx, pairs);
+  return pairs;
+}
+
+std::vector<std::pair<int64_t, int64_t>> RandomTreeEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes,
+    Tree::Shape shape) {
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  if (num_nodes <= 1) return edges;
+  edges.reserve(num_nodes - 1);
+
+  switch (shape) {
+    case Tree::Shape::kAny:
+      edges = RandomPruferTreeEdges(ctx, num_nodes);
+      break;
+    case Tree::Shape::kPath: {
+      std::vector<int64_t> order = RandomOrder(ctx, num_nodes);
+      for (int64_t i = 1; i < num_nodes; i++)
+        edges.emplace_back(order[i - 1], order[i]);
+      break;
+    }
+    case Tree::Shape::kStar: {
+      int64_t center = ctx.RandomInteger(num_nodes);
+      for (int64_t i = 0; i < num_nodes; i++)
+        if (i != center) edges.emplace_back(center, i);
+      break;
+    }
+    case Tree::Shape::kCaterpillar: {
+      // The first `spine_length` nodes form the spine, every other node hangs
+      // off of a random node on the spine.
+      std::vector<int64_t> order = RandomOrder(ctx, num_nodes);
+      int64_t spine_length = ctx.RandomInteger(1, num_nodes);
+      for (int64_t i = 1; i < spine_length; i++)
+        edges.emplace_back(order[i - 1], order[i]);
+      for (int64_t i = spine_length; i < num_nodes; i++)
+        edges.emplace_back(order[ctx.RandomInteger(spine_length)], order[i]);
+      break;
+    }
+  }
+
+  ctx.Shuffle(edges);
+  RandomlyOrient(ctx, edges);
+  return edges;
+}
+
+std::vector<std::pair<int64_t, int64_t>> RandomForestEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes,
+    int64_t num_trees) {
+  if (num_trees > num_nodes || (num_trees <= 0 && num_nodes > 0)) {
+    throw std::invalid_argument(
+        std::format("RandomForestEdges(): cannot split {} nodes into {} trees.",
+                    num_nodes, num_trees));
+  }
+
+  // The first `num_trees` nodes are roots. Every other node is attached to a
+  // random node before it, so never joins two trees.
+  std::vector<int64_t> order = RandomOrder(ctx, num_nodes);
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  edges.reserve(num_nodes - num_trees);
+  for (int64_t i = num_trees; i < num_nodes; i++)
+    edges.emplace_back(order[ctx.RandomInteger(i)], order[i]);
+
+  ctx.Shuffle(edges);
+  RandomlyOrient(ctx, edges);
+  return edges;
+}
+
+std::vector<std::pair<int64_t, int64_t>> RandomGridEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_rows,
+    int64_t num_cols) {
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  edges.reserve(num_rows * std::max<int64_t>(num_cols - 1, 0) +
+                num_cols * std::max<int64_t>(num_rows - 1, 0));
+  for (int64_t r = 0; r < num_rows; r++) {
+    for (int64_t c = 0; c < num_cols; c++) {
+      int64_t cell = r * num_cols + c;
+      if (c + 1 < num_cols) edges.emplace_back(cell, cell + 1);
+      if (r + 1 < num_rows) edges.emplace_back(cell, cell + num_cols);
+    }
+  }
+
+  ctx.Shuffle(edges);
+  RandomlyOrient(ctx, edges);
+  return edges;
+}
+
+std::vector<std::pair<int64_t, int64_t>> RandomBipartiteEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_left,
+    int64_t num_right, int64_t num_edges, bool connected, bool distinct) {
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  edges.reserve(num_edges);
+
+  if (connected && num_left + num_right > 1) {
+    if (num_left == 0 || num_right == 0) {
+      throw std::invalid_argument(
+          "RandomBipartiteEdges(): cannot connect a graph with an empty side.");
+    }
+    // A random spanning tree of the complete bipartite graph: start with one
+    // edge, then add the remaining nodes in a random interleaving, each
+    // attached to a random node already added to the other side.
+    std::vector<int64_t> left = RandomOrder(ctx, num_left);
+    std::vector<int64_t> right = RandomOrder(ctx, num_right);
+    for (int64_t& x : right) x += num_left;
+    edges.emplace_back(left[0], right[0]);
+    int64_t num_added_left = 1;
+    int64_t num_added_right = 1;
+    while (num_added_left < num_left || num_added_right < num_right) {
+      int64_t remaining_left = num_left - num_added_left;
+      int64_t remaining = remaining_left + (num_right - num_added_right);
+      if (ctx.RandomInteger(remaining) < remaining_left) {
+        edges.emplace_back(left[num_added_left++],
+                           right[ctx.RandomInteger(num_added_right)]);
+      } else {
+        edges.emplace_back(left[ctx.RandomInteger(num_added_left)],
+                           right[num_added_right++]);
+      }
+    }
+  }
+  if (static_cast<int64_t>(edges.size()) > num_edges) {
+    throw std::invalid_argument(std::format(
+        "RandomBipartiteEdges(): a connected graph needs at least {} edges.",
+        edges.size()));
+  }
+
+  // Pair (u, v) has index u * num_right + (v - num_left).
+  if (distinct) {
+    std::vector<int64_t> excluded;
+    excluded.reserve(edges.size());
+    for (const auto& [u, v] : edges)
+      excluded.push_back(u * num_right + (v - num_left));
+    for (int64_t index :
+         RandomDistinctIndices(ctx, num_left * num_right,
+                               num_edges - edges.size(), excluded)) {
+      edges.emplace_back(index / num_right, num_left + index % num_right);
+    }
+  } else if (static_cast<int64_t>(edges.size()) < num_edges) {
+    if (num_left == 0 || num_right == 0) {
+      throw std::invalid_argument(
+          "RandomBipartiteEdges(): cannot add edges with an empty side.");
+    }
+    while (static_cast<int64_t>(edges.size()) < num_edges) {
+      edges.emplace_back(ctx.RandomInteger(num_left),
+                         num_left + ctx.RandomInteger(num_right));
+    }
+  }
+
+  RandomlyOrient(ctx, edges);
+  return edges;
+}
+
+void RandomlyRelabelNodes(librarian::GenerateVariableContext ctx,
+                          int64_t num_nodes,
+                          std::vector<std::pair<int64_t, int64_t>>& edges) {
+  std::vector<int64_t> label = RandomOrder(ctx, num_nodes);
+  for (auto& [u, v] : edges) {
+    u = label[u];
+    v = label[v];
+  }
+}
+
+}  // namespace moriarty_internal
+
 }  // namespace moriarty
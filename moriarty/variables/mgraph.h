@@ -15,11 +15,12 @@
 #ifndef MORIARTY_VARIABLES_MGRAPH_H_
 #define MORIARTY_VARIABLES_MGRAPH_H_
 
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
 #include <format>
 #include <optional>
-#include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -63,6 +64,7 @@ struct MVariableValueTypeTrait<MGraph<MEdgeLabel, MNodeLabel>> {
 // Overall style:
 //   - Edge list: each edge is listed on its own line.
 //   - Adjacency matrix: the graph is represented as a matrix.
+//   - Binary adjacency matrix: each row of the matrix is a string of 0s and 1s.
 // Node style:
 //   - 0-based indexing: nodes are numbered from 0 to N-1.
 //   - 1-based indexing: nodes are numbered from 1 to N.
@@ -90,8 +92,19 @@ class MGraphFormat {
   //   edge (currently "0", but this may be configurable in the future).
   MGraphFormat& AdjacencyMatrix();
   // Returns if the format is an adjacency matrix. See `AdjacencyMatrix()`.
+  // This is also true for `BinaryAdjacencyMatrix()`.
   bool IsAdjacencyMatrix() const;
 
+  // Sets the format to a binary adjacency matrix. Each row of the matrix is
+  // written as a single token of N characters with no separators: '1' if
+  // there is an edge between the nodes, and '0' otherwise. E.g., "0110".
+  //
+  // Only valid for graphs without edge labels or parallel edges.
+  MGraphFormat& BinaryAdjacencyMatrix();
+  // Returns if the format is a binary adjacency matrix. See
+  // `BinaryAdjacencyMatrix()`.
+  bool IsBinaryAdjacencyMatrix() const;
+
   // Sets the node style to 0-based indexing. Nodes are numbered from 0 to N-1.
   //
   // This is the default.
@@ -115,7 +128,12 @@ class MGraphFormat {
   void Merge(const MGraphFormat& other);
 
  private:
-  enum class Style { kEdgeList, kAdjacencyMatrix, kNonExhaustiveList };
+  enum class Style {
+    kEdgeList,
+    kAdjacencyMatrix,
+    kBinaryAdjacencyMatrix,
+    kNonExhaustiveList
+  };
   enum class NodeStyle { k0Based, k1Based, kNodeLabels, kNonExhaustiveList };
 
   Style style_ = Style::kEdgeList;
@@ -197,6 +215,14 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
   MGraph& AddConstraint(Loopless constraint);
   // The graph is simple (no parallel edges or self-loops)
   MGraph& AddConstraint(SimpleGraph constraint);
+  // The graph is a tree
+  MGraph& AddConstraint(Tree constraint);
+  // The graph is a forest
+  MGraph& AddConstraint(Forest constraint);
+  // The graph is bipartite
+  MGraph& AddConstraint(Bipartite constraint);
+  // The graph is a grid
+  MGraph& AddConstraint(Grid constraint);
 
   // ---------------------------------------------------------------------------
   //  Constrain edge/node labels
@@ -251,6 +277,28 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
     // Returns whether loops are allowed in the graph.
     [[nodiscard]] bool LoopsAllowed() const;
 
+    // Returns whether the graph is constrained to be a tree.
+    [[nodiscard]] bool IsTree() const;
+    // Returns the required shape of the tree. Only meaningful if IsTree().
+    [[nodiscard]] Tree::Shape TreeShape() const;
+
+    // Returns whether the graph is constrained to be a forest.
+    [[nodiscard]] bool IsForest() const;
+    // Returns all constraints on how many trees are in the forest.
+    [[nodiscard]] const MInteger& NumTrees() const;
+
+    // Returns whether the graph is constrained to be bipartite.
+    [[nodiscard]] bool IsBipartite() const;
+    // Returns the sizes of the two sides of the bipartite graph, if known.
+    [[nodiscard]] std::optional<std::pair<int64_t, int64_t>> BipartiteSides()
+        const;
+
+    // Returns whether the graph is constrained to be a grid.
+    [[nodiscard]] bool IsGrid() const;
+    // Returns the number of rows and columns in the grid. Only meaningful if
+    // IsGrid().
+    [[nodiscard]] std::pair<int64_t, int64_t> GridSize() const;
+
    private:
     friend class MGraph;
     enum Flags : uint32_t {
@@ -262,6 +310,11 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
       kIsConnected = 1 << 4,           // Default: false
       kMultiEdgesDisallowed = 1 << 5,  // Default: false
       kLoopsDisallowed = 1 << 6,       // Default: false
+
+      kIsTree = 1 << 7,       // Default: false
+      kIsForest = 1 << 8,     // Default: false
+      kIsBipartite = 1 << 9,  // Default: false
+      kIsGrid = 1 << 10,      // Default: false
     };
     struct Data {
       std::underlying_type_t<Flags> touched = 0;
@@ -270,6 +323,10 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
       MInteger num_edges;
       MEdgeLabel edge_label_constraints;
       MNodeLabel node_label_constraints;
+      Tree::Shape tree_shape = Tree::Shape::kAny;
+      MInteger num_trees;
+      std::optional<std::pair<int64_t, int64_t>> bipartite_sides;
+      std::pair<int64_t, int64_t> grid_size;
     };
     librarian::CowPtr<Data> data_;
     bool IsSet(Flags flag) const;
@@ -304,6 +361,8 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
 
     void ReadNextEdgeList(librarian::ReadVariableContext ctx);
     void ReadNextAdjacencyMatrix(librarian::ReadVariableContext ctx);
+    void ReadNextBinaryAdjacencyMatrix(librarian::ReadVariableContext ctx,
+                                       int64_t u);
     graph_type FinalizeEdgeList() &&;
     graph_type FinalizeAdjacencyMatrix() &&;
   };
@@ -312,6 +371,18 @@ class MGraph : public librarian::MVariable<MGraph<MEdgeLabel, MNodeLabel>> {
   CoreConstraints core_constraints_;
   MGraphFormat format_;
 
+  int64_t GenerateNumNodes(librarian::GenerateVariableContext ctx,
+                           int64_t min_num_nodes) const;
+  int64_t GenerateNumEdges(librarian::GenerateVariableContext ctx,
+                           int64_t min_num_edges,
+                           std::optional<int64_t> max_num_edges) const;
+  // Generates the number of nodes and the edges of the graph, ignoring labels.
+  std::pair<int64_t, std::vector<std::pair<int64_t, int64_t>>> GenerateEdges(
+      librarian::GenerateVariableContext ctx) const;
+  // Reads an edge list whose nodes are written as 0- or 1-based indices.
+  graph_type ReadIndexedEdgeList(librarian::ReadVariableContext ctx,
+                                 int64_t num_nodes, int64_t num_edges) const;
+
   // ---------------------------------------------------------------------------
   //  MVariable overrides
   graph_type GenerateImpl(
@@ -334,6 +405,69 @@ concept HasEdgeLabels = !std::same_as<MEdgeLabel, MNoEdgeLabel>;
 template <typename MNodeLabel>
 concept HasNodeLabels = !std::same_as<MNodeLabel, MNoNodeLabel>;
 
+namespace moriarty_internal {
+
+// Node pairs {u, v} with u <= v (u < v if loops are not allowed) are indexed
+// in order of v, then u. E.g., without loops: {0, 1} -> 0, {0, 2} -> 1,
+// {1, 2} -> 2, {0, 3} -> 3, ...
+
+// Returns the number of node pairs in a graph with `num_nodes` nodes.
+[[nodiscard]] int64_t NumNodePairs(int64_t num_nodes, bool with_loops);
+
+// Returns the index of the pair {u, v}. Requires u <= v (u < v without loops).
+[[nodiscard]] int64_t NodePairIndex(int64_t u, int64_t v, bool with_loops);
+
+// Returns the pair {u, v} (with u <= v) at `index`.
+[[nodiscard]] std::pair<int64_t, int64_t> NodePairFromIndex(int64_t index,
+                                                            bool with_loops);
+
+// Returns `k` distinct integers in [0, num_indices), chosen uniformly at
+// random from those not in `excluded`, in random order. `excluded` must itself
+// be distinct. Takes O(k + |excluded|) time and memory when the sample is
+// sparse, and O(num_indices) bits when it is dense.
+[[nodiscard]] std::vector<int64_t> RandomDistinctIndices(
+    librarian::GenerateVariableContext ctx, int64_t num_indices, int64_t k,
+    std::span<const int64_t> excluded);
+
+// The functions below return edges in random order and with random
+// orientation. Each takes time linear in the size of the graph it returns.
+
+// Returns `k` distinct node pairs chosen uniformly at random from the pairs
+// not in `excluded`. `excluded` must itself be distinct pairs.
+[[nodiscard]] std::vector<std::pair<int64_t, int64_t>> RandomDistinctNodePairs(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes, int64_t k,
+    bool with_loops, std::span<const std::pair<int64_t, int64_t>> excluded);
+
+// Returns the edges of a random tree with the given shape. With
+// Tree::Shape::kAny, the tree is uniformly random among all labelled trees.
+[[nodiscard]] std::vector<std::pair<int64_t, int64_t>> RandomTreeEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes,
+    Tree::Shape shape);
+
+// Returns the edges of a random forest with exactly `num_trees` trees.
+[[nodiscard]] std::vector<std::pair<int64_t, int64_t>> RandomForestEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_nodes,
+    int64_t num_trees);
+
+// Returns the edges of the `num_rows` x `num_cols` grid graph (see Grid).
+[[nodiscard]] std::vector<std::pair<int64_t, int64_t>> RandomGridEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_rows,
+    int64_t num_cols);
+
+// Returns `num_edges` random edges between nodes [0, num_left) and
+// [num_left, num_left + num_right). If `connected`, the edges start with a
+// random spanning tree. If `distinct`, no edge is repeated.
+[[nodiscard]] std::vector<std::pair<int64_t, int64_t>> RandomBipartiteEdges(
+    librarian::GenerateVariableContext ctx, int64_t num_left,
+    int64_t num_right, int64_t num_edges, bool connected, bool distinct);
+
+// Relabels the nodes [0, num_nodes) of `edges` with a random permutation.
+void RandomlyRelabelNodes(librarian::GenerateVariableContext ctx,
+                          int64_t num_nodes,
+                          std::vector<std::pair<int64_t, int64_t>>& edges);
+
+}  // namespace moriarty_internal
+
 template <typename MEdgeLabel, typename MNodeLabel>
 template <typename... Constraints>
   requires(ConstraintFor<MGraph<MEdgeLabel, MNodeLabel>, Constraints> && ...)
@@ -410,6 +544,44 @@ MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
   return this->InternalAddConstraint(std::move(constraint));
 }
 
+template <typename MEdgeLabel, typename MNodeLabel>
+MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
+    Tree constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kIsTree;
+  if (constraint.GetShape() != Tree::Shape::kAny)
+    constraints.tree_shape = constraint.GetShape();
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
+    Forest constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kIsForest;
+  constraints.num_trees.MergeFrom(constraint.GetNumTrees());
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
+    Bipartite constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kIsBipartite;
+  if (constraint.GetSides())
+    constraints.bipartite_sides = constraint.GetSides();
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
+    Grid constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kIsGrid;
+  constraints.grid_size = {constraint.NumRows(), constraint.NumCols()};
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
 template <typename MEdgeLabel, typename MNodeLabel>
 MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
     EdgeLabels<MEdgeLabel> constraint) {
@@ -436,42 +608,117 @@ MGraph<MEdgeLabel, MNodeLabel>& MGraph<MEdgeLabel, MNodeLabel>::AddConstraint(
 }
 
 template <typename MEdgeLabel, typename MNodeLabel>
-typename MGraph<MEdgeLabel, MNodeLabel>::graph_type
-MGraph<MEdgeLabel, MNodeLabel>::GenerateImpl(
-    librarian::GenerateVariableContext ctx) const {
-  if (this->GetOneOf().HasBeenConstrained())
-    return this->GetOneOf().SelectOneOf(
-        [&](int n) { return ctx.RandomInteger(n); });
-
-  // TODO: These checks are too strong when we constrain in other ways (simple,
-  // tree, connected, planar, etc)
+int64_t MGraph<MEdgeLabel, MNodeLabel>::GenerateNumNodes(
+    librarian::GenerateVariableContext ctx, int64_t min_num_nodes) const {
   if (!core_constraints_.NumNodesConstrained()) {
     throw GenerationError(ctx.GetLocalVariableName(),
                           "Need NumNodes() to generate a graph",
                           RetryPolicy::kAbort);
   }
+  MInteger node_con = core_constraints_.NumNodes();
+  node_con.AddConstraint(AtLeast(min_num_nodes));
+  return node_con.Generate(ctx.ForSubVariable("num_nodes"));
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+int64_t MGraph<MEdgeLabel, MNodeLabel>::GenerateNumEdges(
+    librarian::GenerateVariableContext ctx, int64_t min_num_edges,
+    std::optional<int64_t> max_num_edges) const {
   if (!core_constraints_.NumEdgesConstrained()) {
     throw GenerationError(ctx.GetLocalVariableName(),
                           "Need NumEdges() to generate a graph",
                           RetryPolicy::kAbort);
   }
+  MInteger edge_con = core_constraints_.NumEdges();
+  edge_con.AddConstraint(AtLeast(min_num_edges));
+  if (max_num_edges) edge_con.AddConstraint(AtMost(*max_num_edges));
+  return edge_con.Generate(ctx.ForSubVariable("num_edges"));
+}
 
-  MInteger node_con = core_constraints_.NumNodes();
-  node_con.AddConstraint(AtLeast(0));
+template <typename MEdgeLabel, typename MNodeLabel>
+auto MGraph<MEdgeLabel, MNodeLabel>::GenerateEdges(
+    librarian::GenerateVariableContext ctx) const
+    -> std::pair<int64_t, std::vector<std::pair<int64_t, int64_t>>> {
+  // Structured graphs are generated directly. If several structures are
+  // requested, the first one below is generated and the others are checked
+  // afterwards.
+  if (core_constraints_.IsGrid()) {
+    auto [num_rows, num_cols] = core_constraints_.GridSize();
+    return {num_rows * num_cols,
+            moriarty_internal::RandomGridEdges(ctx, num_rows, num_cols)};
+  }
 
-  int64_t num_nodes = node_con.Generate(ctx.ForSubVariable("num_nodes"));
+  if (core_constraints_.IsTree()) {
+    int64_t num_nodes = GenerateNumNodes(ctx, 1);
+    return {num_nodes, moriarty_internal::RandomTreeEdges(
+                           ctx, num_nodes, core_constraints_.TreeShape())};
+  }
 
-  MInteger edge_con = core_constraints_.NumEdges();
-  edge_con.AddConstraint(AtLeast(0));
-  if (core_constraints_.IsConnected())
-    edge_con.AddConstraint(AtLeast(num_nodes - 1));
-  if (!core_constraints_.MultiEdgesAllowed()) {
-    if (core_constraints_.LoopsAllowed())
-      edge_con.AddConstraint(AtMost((num_nodes * (num_nodes + 1)) / 2));
-    else
-      edge_con.AddConstraint(AtMost((num_nodes * (num_nodes - 1)) / 2));
+  if (core_constraints_.IsForest()) {
+    int64_t num_nodes = GenerateNumNodes(ctx, 0);
+    int64_t num_trees;
+    if (core_constraints_.IsConnected()) {
+      num_trees = std::min<int64_t>(num_nodes, 1);
+    } else if (core_constraints_.NumEdgesConstrained()) {
+      int64_t max_num_edges = std::max<int64_t>(num_nodes - 1, 0);
+      num_trees = num_nodes - GenerateNumEdges(ctx, 0, max_num_edges);
+    } else {
+      MInteger tree_con = core_constraints_.NumTrees();
+      tree_con.AddConstraint(Between(std::min<int64_t>(num_nodes, 1),
+                                     num_nodes));
+      num_trees = tree_con.Generate(ctx.ForSubVariable("num_trees"));
+    }
+    return {num_nodes, moriarty_internal::RandomForestEdges(ctx, num_nodes,
+                                                            num_trees)};
+  }
+
+  bool connected = core_constraints_.IsConnected();
+  bool distinct = !core_constraints_.MultiEdgesAllowed();
+
+  if (core_constraints_.IsBipartite()) {
+    std::optional<std::pair<int64_t, int64_t>> sides =
+        core_constraints_.BipartiteSides();
+    int64_t num_nodes =
+        sides ? sides->first + sides->second : GenerateNumNodes(ctx, 0);
+    int64_t min_num_edges = connected ? std::max<int64_t>(num_nodes - 1, 0) : 0;
+
+    // Without fixed sides, the most edges come from an even split.
+    int64_t num_left = sides ? sides->first : num_nodes / 2;
+    int64_t num_right = num_nodes - num_left;
+    if (connected && num_nodes > 1 && (num_left == 0 || num_right == 0)) {
+      throw GenerationError(
+          ctx.GetLocalVariableName(),
+          "Cannot generate a connected bipartite graph with an empty side",
+          RetryPolicy::kAbort);
+    }
+    std::optional<int64_t> max_num_edges;
+    if (distinct || num_left == 0 || num_right == 0)
+      max_num_edges = num_left * num_right;
+    int64_t num_edges = GenerateNumEdges(ctx, min_num_edges, max_num_edges);
+
+    if (!sides) {
+      // Choose a random split that can hold all of the edges.
+      int64_t min_left = (num_nodes >= 2 && (connected || num_edges > 0));
+      while (distinct && min_left * (num_nodes - min_left) < num_edges)
+        min_left++;
+      num_left = ctx.RandomInteger(min_left, num_nodes - min_left);
+      num_right = num_nodes - num_left;
+    }
+
+    auto edges = moriarty_internal::RandomBipartiteEdges(
+        ctx, num_left, num_right, num_edges, connected, distinct);
+    if (!sides) moriarty_internal::RandomlyRelabelNodes(ctx, num_nodes, edges);
+    return {num_nodes, std::move(edges)};
   }
-  int64_t num_edges = edge_con.Generate(ctx.ForSubVariable("num_edges"));
+
+  int64_t num_nodes = GenerateNumNodes(ctx, 0);
+  std::optional<int64_t> max_num_edges;
+  if (distinct) {
+    max_num_edges = moriarty_internal::NumNodePairs(
+        num_nodes, core_constraints_.LoopsAllowed());
+  }
+  int64_t num_edges = GenerateNumEdges(
+      ctx, connected ? num_nodes - 1 : 0, max_num_edges);
 
   if (num_nodes == 0 && num_edges > 0) {
     throw GenerationError(ctx.GetLocalVariableName(),
@@ -479,15 +726,43 @@ MGraph<MEdgeLabel, MNodeLabel>::GenerateImpl(
                           RetryPolicy::kAbort);
   }
 
-  std::set<
-      std::pair<typename graph_type::NodeIdx, typename graph_type::NodeIdx>>
-      seen;
-  graph_type G(num_nodes);
+  std::vector<std::pair<int64_t, int64_t>> edges;
+  edges.reserve(num_edges);
+  if (connected) {
+    for (int64_t i = 1; i < num_nodes; ++i) {
+      edges.emplace_back(i, ctx.RandomInteger(i));
+    }
+  }
+
+  if (distinct) {
+    // The spanning tree's edges are distinct, so the rest are sampled from the
+    // pairs it does not use.
+    auto rest = moriarty_internal::RandomDistinctNodePairs(
+        ctx, num_nodes, num_edges - edges.size(),
+        core_constraints_.LoopsAllowed(), edges);
+    edges.insert(edges.end(), rest.begin(), rest.end());
+  }
+
+  while (edges.size() < num_edges) {
+    int64_t u = ctx.RandomInteger(num_nodes);
+    int64_t v = ctx.RandomInteger(num_nodes);
+    if (!core_constraints_.LoopsAllowed() && u == v) continue;
+    edges.emplace_back(u, v);
+  }
+  return {num_nodes, std::move(edges)};
+}
 
-  auto add_edge_with_label = [this, &G, &seen, &ctx](int64_t u, int64_t v) {
-    seen.emplace(u, v);
-    seen.emplace(v, u);
+template <typename MEdgeLabel, typename MNodeLabel>
+typename MGraph<MEdgeLabel, MNodeLabel>::graph_type
+MGraph<MEdgeLabel, MNodeLabel>::GenerateImpl(
+    librarian::GenerateVariableContext ctx) const {
+  if (this->GetOneOf().HasBeenConstrained())
+    return this->GetOneOf().SelectOneOf(
+        [&](int n) { return ctx.RandomInteger(n); });
 
+  auto [num_nodes, edges] = GenerateEdges(ctx);
+  graph_type G(num_nodes);
+  for (const auto& [u, v] : edges) {
     if constexpr (!HasEdgeLabels<MEdgeLabel>) {
       G.AddEdge(u, v);
     } else {
@@ -496,22 +771,6 @@ MGraph<MEdgeLabel, MNodeLabel>::GenerateImpl(
           ctx.ForSubVariable("edge_label"));
       G.AddEdge(u, v, edge_label);
     }
-  };
-
-  if (core_constraints_.IsConnected()) {
-    for (int64_t i = 1; i < num_nodes; ++i) {
-      int64_t v = ctx.RandomInteger(i);
-      add_edge_with_label(i, v);
-    }
-  }
-
-  while (G.NumEdges() < num_edges) {
-    int64_t u = ctx.RandomInteger(num_nodes);
-    int64_t v = ctx.RandomInteger(num_nodes);
-    if (!core_constraints_.LoopsAllowed() && u == v) continue;
-    if (!core_constraints_.MultiEdgesAllowed() && !seen.emplace(u, v).second)
-      continue;
-    add_edge_with_label(u, v);
   }
 
   if constexpr (HasNodeLabels<MNodeLabel>) {
@@ -551,6 +810,10 @@ MGraph<MEdgeLabel, MNodeLabel>::ReadImpl(
   if (!num_edges)
     ctx.ThrowIOError("Cannot determine the number of edges before read.");
 
+  if (Format().IsEdgeList() && !Format().IsNodeLabelsStyle()) {
+    return ReadIndexedEdgeList(ctx, *num_nodes, *num_edges);
+  }
+
   if (Format().IsEdgeList()) {
     MGraph::Reader reader(ctx, *num_edges, *this);
     for (int64_t i = 0; i < *num_edges; i++) {
@@ -563,11 +826,57 @@ MGraph<MEdgeLabel, MNodeLabel>::ReadImpl(
   ctx.ThrowIOError("Unsupported MGraph format for reading.");
 }
 
+template <typename MEdgeLabel, typename MNodeLabel>
+typename MGraph<MEdgeLabel, MNodeLabel>::graph_type
+MGraph<MEdgeLabel, MNodeLabel>::ReadIndexedEdgeList(
+    librarian::ReadVariableContext ctx, int64_t num_nodes,
+    int64_t num_edges) const {
+  const int64_t offset = Format().IsOneBased() ? 1 : 0;
+  auto read_node = [&]() {
+    int64_t node = ctx.ReadInteger();
+    if (node < offset || node - offset >= num_nodes) {
+      ctx.ThrowIOError("Invalid ({}-based) node index {} for graph with {} "
+                       "nodes.",
+                       offset, node, num_nodes);
+    }
+    return node - offset;
+  };
+
+  // Loops are cheap to reject here, where the cursor still points at the
+  // offending edge. Everything else is checked once the graph is complete.
+  const bool loops_allowed = core_constraints_.LoopsAllowed();
+  if (num_edges < 0) {
+    ctx.ThrowIOError("Cannot read a negative number of edges ({}).",
+                     num_edges);
+  }
+  graph_type G(num_nodes);
+  // Don't trust `num_edges` with a huge allocation before any edge is read.
+  G.ReserveEdges(std::min<int64_t>(num_edges, 1 << 20));
+  for (int64_t i = 0; i < num_edges; i++) {
+    int64_t u = read_node();
+    ctx.ReadWhitespace(Whitespace::kSpace);
+    int64_t v = read_node();
+    if (!loops_allowed && u == v) {
+      ctx.ThrowIOError("Edge {} is a loop at node {}, but loops are not "
+                       "allowed.",
+                       i, u + offset);
+    }
+    if constexpr (!HasEdgeLabels<MEdgeLabel>) {
+      G.AddEdge(u, v);
+    } else {
+      ctx.ReadWhitespace(Whitespace::kSpace);
+      G.AddEdge(u, v, core_constraints_.EdgeLabels().Read(ctx));
+    }
+    ctx.ReadWhitespace(Whitespace::kNewline);
+  }
+  return G;
+}
+
 template <typename MEdgeLabel, typename MNodeLabel>
 void MGraph<MEdgeLabel, MNodeLabel>::WriteImpl(
     librarian::WriteVariableContext ctx, const graph_type& value) const {
   if (format_.IsEdgeList()) {
-    auto node_labels = value.GetNodeLabels();
+    const auto& node_labels = value.GetNodeLabels();
     auto write_node = [this, &ctx,
                        &node_labels](typename graph_type::NodeIdx node) {
       if (format_.IsZeroBased()) {
@@ -587,7 +896,7 @@ void MGraph<MEdgeLabel, MNodeLabel>::WriteImpl(
         throw std::runtime_error("Unreachable code reached.");
       }
     };
-    for (const auto& [u, v, w] : value.GetEdges()) {
+    for (const auto& [u, v, w] : value.Edges()) {
       write_node(u);
       ctx.WriteWhitespace(Whitespace::kSpace);
       write_node(v);
@@ -601,48 +910,63 @@ void MGraph<MEdgeLabel, MNodeLabel>::WriteImpl(
   }
 
   if (format_.IsAdjacencyMatrix()) {
-    auto adjacency_list = value.GetAdjacencyList();
+    // The matrix is written one row at a time from each node's adjacent edges,
+    // so only a single row is ever held in memory.
+    const int64_t num_nodes = value.NumNodes();
     if constexpr (!HasEdgeLabels<MEdgeLabel>) {
-      std::vector<std::vector<int64_t>> matrix(
-          adjacency_list.size(),
-          std::vector<int64_t>(adjacency_list.size(), 0));
-      for (size_t u = 0; u < adjacency_list.size(); ++u) {
-        for (auto [_, v, w] : adjacency_list[u]) {
-          matrix[u][v]++;
-        }
-      }
-      for (size_t u = 0; u < adjacency_list.size(); ++u) {
-        for (size_t v = 0; v < adjacency_list.size(); ++v) {
-          if (v > 0) ctx.WriteWhitespace(Whitespace::kSpace);
-          ctx.WriteToken(std::to_string(matrix[u][v]));
+      std::vector<int64_t> row(num_nodes, 0);
+      std::string binary_row;
+      for (int64_t u = 0; u < num_nodes; ++u) {
+        for (const auto& [_, v, w] : value.AdjacentEdges(u)) row[v]++;
+        if (format_.IsBinaryAdjacencyMatrix()) {
+          binary_row.assign(num_nodes, '0');
+          for (const auto& [_, v, w] : value.AdjacentEdges(u)) {
+            if (row[v] > 1) {
+              // FIXME: This should be an IOError.
+              throw std::runtime_error(
+                  "Cannot write binary adjacency matrix with multiple edges "
+                  "between nodes.");
+            }
+            binary_row[v] = '1';
+          }
+          ctx.WriteToken(binary_row);
+        } else {
+          for (int64_t v = 0; v < num_nodes; ++v) {
+            if (v > 0) ctx.WriteWhitespace(Whitespace::kSpace);
+            ctx.WriteToken(std::to_string(row[v]));
+          }
         }
+        for (const auto& [_, v, w] : value.AdjacentEdges(u)) row[v] = 0;
         ctx.WriteWhitespace(Whitespace::kNewline);
       }
     } else {  // HasEdgeLabels == true
-      std::vector<std::vector<std::optional<typename MEdgeLabel::value_type>>>
-          matrix(value.NumNodes(),
-                 std::vector<std::optional<typename MEdgeLabel::value_type>>(
-                     value.NumNodes()));
-      for (const auto& row : adjacency_list) {
-        for (auto [u, v, w] : row) {
-          if (matrix[u][v].has_value()) {
+      if (format_.IsBinaryAdjacencyMatrix()) {
+        // FIXME: This should be an IOError.
+        throw std::runtime_error(
+            "Cannot write binary adjacency matrix when edge labels are "
+            "present.");
+      }
+      std::vector<const typename MEdgeLabel::value_type*> row(num_nodes,
+                                                               nullptr);
+      for (int64_t u = 0; u < num_nodes; ++u) {
+        for (const auto& [_, v, w] : value.AdjacentEdges(u)) {
+          if (row[v] != nullptr) {
             // FIXME: This should be an IOError.
             throw std::runtime_error(
                 "Cannot write adjacency matrix with multiple edges "
                 "between nodes when edge labels are present.");
           }
-          matrix[u][v] = w;
+          row[v] = &w;
         }
-      }
-      for (size_t u = 0; u < value.NumNodes(); ++u) {
-        for (size_t v = 0; v < value.NumNodes(); ++v) {
+        for (int64_t v = 0; v < num_nodes; ++v) {
           if (v > 0) ctx.WriteWhitespace(Whitespace::kSpace);
-          if (!matrix[u][v]) {
+          if (row[v] == nullptr) {
             ctx.WriteToken("0");  // FIXME: Better representation of no edge
           } else {
-            core_constraints_.EdgeLabels().Write(ctx, *matrix[u][v]);
+            core_constraints_.EdgeLabels().Write(ctx, *row[v]);
           }
         }
+        for (const auto& [_, v, w] : value.AdjacentEdges(u)) row[v] = nullptr;
         ctx.WriteWhitespace(Whitespace::kNewline);
       }
     }
@@ -752,6 +1076,7 @@ MGraph<MEdgeLabel, MNodeLabel>::Reader::Reader(
   }
 
   G_ = graph_type(*num_nodes);
+  if (variable_.get().Format().IsEdgeList()) G_.ReserveEdges(num_chunks);
 }
 
 template <typename MEdgeLabel, typename MNodeLabel>
@@ -828,6 +1153,11 @@ void MGraph<MEdgeLabel, MNodeLabel>::Reader::ReadNextAdjacencyMatrix(
     librarian::ReadVariableContext ctx) {
   int64_t u = chunks_read_++;
 
+  if (variable_.get().Format().IsBinaryAdjacencyMatrix()) {
+    ReadNextBinaryAdjacencyMatrix(ctx, u);
+    return;
+  }
+
   for (typename graph_type::NodeIdx v = 0; v < G_.NumNodes(); ++v) {
     if (v > 0) ctx.ReadWhitespace(Whitespace::kSpace);
 
@@ -868,6 +1198,39 @@ void MGraph<MEdgeLabel, MNodeLabel>::Reader::ReadNextAdjacencyMatrix(
   }
 }
 
+template <typename MEdgeLabel, typename MNodeLabel>
+void MGraph<MEdgeLabel, MNodeLabel>::Reader::ReadNextBinaryAdjacencyMatrix(
+    librarian::ReadVariableContext ctx, int64_t u) {
+  if constexpr (HasEdgeLabels<MEdgeLabel>) {
+    ctx.ThrowIOError(
+        "Cannot read binary adjacency matrix when edge labels are present.");
+  } else {
+    auto& adj = std::get<IMtxIdx>(adjacency_matrix_);
+    std::string row = ctx.ReadToken();
+    if (std::ssize(row) != G_.NumNodes()) {
+      ctx.ThrowIOError(
+          "Binary adjacency matrix row {} has length {}, but expected {}.", u,
+          row.size(), G_.NumNodes());
+    }
+    for (typename graph_type::NodeIdx v = 0; v < G_.NumNodes(); ++v) {
+      if (row[v] != '0' && row[v] != '1') {
+        ctx.ThrowIOError(
+            "Invalid character '{}' in binary adjacency matrix at ({}, {}).",
+            row[v], u, v);
+      }
+      int64_t edge_count = row[v] - '0';
+      if (u > v && adj[v][u] != edge_count) {
+        ctx.ThrowIOError(
+            "Asymmetric adjacency matrix entries at ({}, {}) = {} "
+            "and ({}, {}) = {}",
+            u, v, adj[v][u], v, u, edge_count);
+      }
+      adj[u][v] = edge_count;
+      if (u <= v && edge_count == 1) G_.AddEdge(u, v);
+    }
+  }
+}
+
 template <typename MEdgeLabel, typename MNodeLabel>
 void MGraph<MEdgeLabel, MNodeLabel>::Reader::ReadNext(
     librarian::ReadVariableContext ctx) {
@@ -958,6 +1321,49 @@ bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::LoopsAllowed() const {
   return !IsSet(Flags::kLoopsDisallowed);
 }
 
+template <typename MEdgeLabel, typename MNodeLabel>
+bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::IsTree() const {
+  return IsSet(Flags::kIsTree);
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+Tree::Shape MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::TreeShape() const {
+  return data_->tree_shape;
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::IsForest() const {
+  return IsSet(Flags::kIsForest);
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+const MInteger& MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::NumTrees()
+    const {
+  return data_->num_trees;
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::IsBipartite() const {
+  return IsSet(Flags::kIsBipartite);
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+std::optional<std::pair<int64_t, int64_t>>
+MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::BipartiteSides() const {
+  return data_->bipartite_sides;
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::IsGrid() const {
+  return IsSet(Flags::kIsGrid);
+}
+
+template <typename MEdgeLabel, typename MNodeLabel>
+std::pair<int64_t, int64_t>
+MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::GridSize() const {
+  return data_->grid_size;
+}
+
 template <typename MEdgeLabel, typename MNodeLabel>
 bool MGraph<MEdgeLabel, MNodeLabel>::CoreConstraints::IsSet(Flags flag) const {
   return (data_->touched & static_cast<std::underlying_type_t<Flags>>(flag)) !=
@@ -14,12 +14,18 @@
 
 #include "moriarty/variables/mgraph.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <optional>
+#include <set>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <utility>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -39,6 +45,7 @@ namespace moriarty {
 namespace {
 
 using ::moriarty_testing::Context;
+using ::moriarty_testing::Generate;
 using ::moriarty_testing::GeneratedValuesAre;
 using ::moriarty_testing::GenerateThrowsGenerationError;
 using ::moriarty_testing::HasNoViolation;
@@ -48,8 +55,11 @@ using ::moriarty_testing::Write;
 using ::testing::AllOf;
 using ::testing::AnyOf;
 using ::testing::Eq;
+using ::testing::Ge;
 using ::testing::HasSubstr;
+using ::testing::Le;
 using ::testing::Optional;
+using ::testing::ThrowsMessage;
 using ::testing::Truly;
 using ::testing::UnorderedElementsAre;
 
@@ -188,6 +198,52 @@ TEST(MGraphTest, ReadWeightedAdjMatrixShouldSucceed) {
       graph, "moriarty/variables/testing/mgraph/matrix_sym_ints_1diag.in", context);
 }
 
+TEST(MGraphTest, WriteAdjMatrixShouldSucceed) {
+  EXPECT_EQ(Write(MGraph(MGraphFormat().AdjacencyMatrix()), Graph1()),
+            "0 1 0\n1 0 2\n0 2 0\n");
+
+  Graph<int64_t, NoNodeLabel> weighted(3);
+  weighted.AddEdge(0, 2, 5).AddEdge(1, 1, 7);
+  EXPECT_EQ(Write(MGraph<MInteger>(MGraphFormat().AdjacencyMatrix()), weighted),
+            "0 0 5\n0 7 0\n5 0 0\n");
+}
+
+Graph<NoEdgeLabel, NoNodeLabel> Cycle4() {
+  Graph G(4);
+  G.AddEdge(0, 1).AddEdge(0, 3).AddEdge(1, 2).AddEdge(2, 3);
+  return G;
+}
+
+TEST(MGraphTest, BinaryAdjMatrixShouldRoundTrip) {
+  MGraph graph(NumNodes(4), MGraphFormat().BinaryAdjacencyMatrix());
+  EXPECT_EQ(Write(graph, Cycle4()), "0101\n1010\n0101\n1010\n");
+  EXPECT_EQ(Read(graph, "0101\n1010\n0101\n1010\n"), Cycle4());
+  EXPECT_EQ(Write(MGraph(MGraphFormat().BinaryAdjacencyMatrix()),
+                  Graph<NoEdgeLabel, NoNodeLabel>(2).AddEdge(1, 1)),
+            "00\n01\n");
+}
+
+TEST(MGraphTest, BinaryAdjMatrixShouldRejectInvalidRows) {
+  MGraph graph(NumNodes(2), MGraphFormat().BinaryAdjacencyMatrix());
+  EXPECT_THROW((void)Read(graph, "011\n100\n"), IOError);
+  EXPECT_THROW((void)Read(graph, "02\n20\n"), IOError);
+  EXPECT_THROW((void)Read(graph, "01\n00\n"), IOError);
+  EXPECT_THROW(
+      (void)Write(MGraph(MGraphFormat().BinaryAdjacencyMatrix()), Graph1()),
+      std::runtime_error);
+}
+
+TEST(MGraphTest, WriteLargeAdjMatrixShouldSucceed) {
+  constexpr int64_t kNumNodes = 2000;
+  Graph<NoEdgeLabel, NoNodeLabel> path(kNumNodes);
+  for (int64_t i = 0; i + 1 < kNumNodes; i++) path.AddEdge(i, i + 1);
+
+  std::string matrix =
+      Write(MGraph(MGraphFormat().BinaryAdjacencyMatrix()), path);
+  EXPECT_EQ(matrix.size(), kNumNodes * (kNumNodes + 1));
+  EXPECT_EQ(std::ranges::count(matrix, '1'), 2 * (kNumNodes - 1));
+}
+
 TEST(MGraphTest, ReadUnweightedEdgeListShouldSucceed) {
   Context context;
   {
@@ -420,6 +476,50 @@ TEST(MGraphTest, ReadShouldFailOnInvalidInput) {
       IOError);
 }
 
+TEST(MGraphTest, ReadEdgeListShouldRejectLoopsWhileReading) {
+  EXPECT_THAT(
+      [] {
+        (void)Read(MGraph(NumNodes(3), NumEdges(3), Loopless()),
+                   "0 1\n1 1\n1 2\n");
+      },
+      ThrowsMessage<IOError>(HasSubstr("Edge 1 is a loop at node 1")));
+  EXPECT_THAT(
+      [] {
+        (void)Read(MGraph(NumNodes(3), NumEdges(1), Loopless(),
+                          MGraphFormat().OneBased()),
+                   "3 3\n");
+      },
+      ThrowsMessage<IOError>(HasSubstr("loop at node 3")));
+  EXPECT_THAT(
+      [] {
+        (void)Read(MGraph(NumNodes(3), NumEdges(1), MGraphFormat().OneBased()),
+                   "0 1\n");
+      },
+      ThrowsMessage<IOError>(HasSubstr("Invalid (1-based) node index 0")));
+}
+
+TEST(MGraphTest, ReadEdgeListWithInvalidNumEdgesShouldFail) {
+  EXPECT_THAT([] { (void)Read(MGraph(NumNodes(3), NumEdges(-1)), ""); },
+              ThrowsMessage<IOError>(HasSubstr("negative number of edges")));
+  // Runs out of input long before the reservation could be a problem.
+  EXPECT_THROW(
+      (void)Read(MGraph(NumNodes(3), NumEdges(1'000'000'000'000)), "0 1\n"),
+      IOError);
+}
+
+TEST(MGraphTest, ReadLargeEdgeListShouldSucceed) {
+  constexpr int64_t kNumNodes = 200'000;
+  std::string input;
+  for (int64_t i = 1; i < kNumNodes; i++) {
+    input += std::format("{} {}\n", i, i + 1);
+  }
+  Graph<NoEdgeLabel, NoNodeLabel> G = Read(
+      MGraph(NumNodes(kNumNodes), NumEdges(kNumNodes - 1), SimpleGraph(),
+             Connected(), MGraphFormat().OneBased()),
+      input);
+  EXPECT_EQ(G.NumEdges(), kNumNodes - 1);
+}
+
 MATCHER_P(NumNodesIs, matcher, "has the correct number of nodes") {
   return ::testing::ExplainMatchResult(matcher, arg.NumNodes(),
                                        result_listener);
@@ -449,6 +549,122 @@ TEST(MGraphTest, GenerateShouldFailOnMissingConstraints) {
               GenerateThrowsGenerationError("", Context()));
 }
 
+MATCHER(HasNoRepeatedEdges, "has no repeated edges") {
+  std::set<std::pair<int64_t, int64_t>> seen;
+  for (const auto& [u, v, e] : arg.GetEdges()) {
+    if (!seen.insert(std::minmax(u, v)).second) {
+      *result_listener << "edge (" << u << ", " << v << ") is repeated";
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(MGraphTest, GenerateDenseSimpleGraphsShouldSucceed) {
+  EXPECT_THAT(MGraph(NumNodes(50), NumEdges(50 * 49 / 2), SimpleGraph()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(50 * 49 / 2)), HasNoRepeatedEdges())));
+  EXPECT_THAT(MGraph(NumNodes(50), NumEdges(1000), SimpleGraph()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(1000)), HasNoRepeatedEdges())));
+  EXPECT_THAT(
+      MGraph(NumNodes(50), NumEdges(Between(1100, 1200)), SimpleGraph(),
+             Connected()),
+      GeneratedValuesAre(HasNoRepeatedEdges()));
+  EXPECT_THAT(MGraph(NumNodes(20), NumEdges(20 * 21 / 2), NoParallelEdges()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(20 * 21 / 2)), HasNoRepeatedEdges())));
+}
+
+TEST(MGraphTest, GenerateSparseSimpleGraphsShouldSucceed) {
+  EXPECT_THAT(MGraph(NumNodes(1000), NumEdges(2000), SimpleGraph()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(2000)), HasNoRepeatedEdges())));
+  EXPECT_THAT(MGraph(NumNodes(100), NumEdges(150), SimpleGraph(), Connected()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(150)), HasNoRepeatedEdges())));
+}
+
+TEST(MGraphTest, GenerateTreesShouldSucceed) {
+  EXPECT_THAT(MGraph(NumNodes(Between(1, 50)), Tree()),
+              GeneratedValuesAre(Truly([](const Graph<>& G) {
+                return G.NumEdges() == G.NumNodes() - 1;
+              })));
+  EXPECT_THAT(MGraph(NumNodes(30), Tree::Path()),
+              GeneratedValuesAre(NumEdgesIs(Eq(29))));
+  EXPECT_THAT(MGraph(NumNodes(30), Tree::Star()),
+              GeneratedValuesAre(NumEdgesIs(Eq(29))));
+  EXPECT_THAT(MGraph(NumNodes(30), Tree::Caterpillar()),
+              GeneratedValuesAre(NumEdgesIs(Eq(29))));
+  EXPECT_THAT(MGraph(NumNodes(10), Tree(), Connected(), SimpleGraph()),
+              GeneratedValuesAre(NumEdgesIs(Eq(9))));
+  EXPECT_THAT((MGraph<MInteger>(NumNodes(10), Tree(),
+                                EdgeLabels<MInteger>(Between(1, 5)))),
+              GeneratedValuesAre(NumEdgesIs(Eq(9))));
+}
+
+TEST(MGraphTest, GenerateLargeTreeShouldSucceed) {
+  EXPECT_THAT(Generate(MGraph(NumNodes(200000), Tree())),
+              NumEdgesIs(Eq(199999)));
+}
+
+TEST(MGraphTest, GenerateForestsShouldSucceed) {
+  EXPECT_THAT(MGraph(NumNodes(30), Forest(4)),
+              GeneratedValuesAre(NumEdgesIs(Eq(26))));
+  EXPECT_THAT(MGraph(NumNodes(30), Forest("K")),
+              GeneratedValuesAre(NumEdgesIs(Eq(23)),
+                                 Context().WithValue<MInteger>("K", 7)));
+  EXPECT_THAT(MGraph(NumNodes(30), Forest(), NumEdges(20)),
+              GeneratedValuesAre(NumEdgesIs(Eq(20))));
+  EXPECT_THAT(MGraph(NumNodes(30), Forest()),
+              GeneratedValuesAre(NumEdgesIs(AllOf(Ge(0), Le(29)))));
+  EXPECT_THAT(MGraph(NumNodes(30), Forest(), Connected()),
+              GeneratedValuesAre(NumEdgesIs(Eq(29))));
+}
+
+TEST(MGraphTest, GenerateBipartiteGraphsShouldSucceed) {
+  EXPECT_THAT(MGraph(Bipartite(5, 7), NumEdges(35), SimpleGraph()),
+              GeneratedValuesAre(
+                  AllOf(NumNodesIs(Eq(12)), NumEdgesIs(Eq(35)),
+                        HasNoRepeatedEdges())));
+  EXPECT_THAT(MGraph(Bipartite(5, 7), NumEdges(11), Connected()),
+              GeneratedValuesAre(NumEdgesIs(Eq(11))));
+  EXPECT_THAT(MGraph(Bipartite(5, 7), NumEdges(100)),
+              GeneratedValuesAre(NumEdgesIs(Eq(100))));
+  EXPECT_THAT(MGraph(Bipartite(), NumNodes(20), NumEdges(100), SimpleGraph()),
+              GeneratedValuesAre(
+                  AllOf(NumEdgesIs(Eq(100)), HasNoRepeatedEdges())));
+  EXPECT_THAT(MGraph(Bipartite(), NumNodes(20), NumEdges(19), Connected()),
+              GeneratedValuesAre(NumEdgesIs(Eq(19))));
+  EXPECT_THAT(MGraph(Bipartite(0, 3), NumEdges(1), Connected()),
+              GenerateThrowsGenerationError("", Context()));
+}
+
+TEST(MGraphTest, GenerateGridsShouldSucceed) {
+  EXPECT_THAT(MGraph(Grid(4, 6)),
+              GeneratedValuesAre(AllOf(NumNodesIs(Eq(24)), NumEdgesIs(Eq(38)),
+                                       HasNoRepeatedEdges())));
+  EXPECT_THAT(MGraph(Grid(1, 1)),
+              GeneratedValuesAre(AllOf(NumNodesIs(Eq(1)), NumEdgesIs(Eq(0)))));
+  EXPECT_THAT(MGraph(Grid(3, 3), Connected(), Bipartite()),
+              GeneratedValuesAre(NumEdgesIs(Eq(12))));
+}
+
+TEST(MGraphTest, NodePairIndicesShouldRoundTrip) {
+  for (bool with_loops : {false, true}) {
+    int64_t index = 0;
+    for (int64_t v = 0; v < 100; v++) {
+      for (int64_t u = 0; u < v + (with_loops ? 1 : 0); u++) {
+        EXPECT_EQ(moriarty_internal::NodePairIndex(u, v, with_loops), index);
+        EXPECT_EQ(moriarty_internal::NodePairFromIndex(index, with_loops),
+                  std::make_pair(u, v));
+        index++;
+      }
+    }
+    EXPECT_EQ(moriarty_internal::NumNodePairs(100, with_loops), index);
+  }
+}
+
 TEST(MGraphTest, GetUniqueValueShouldSucceed) {
   moriarty_internal::VariableSet variables;
   moriarty_internal::ValueSet values;
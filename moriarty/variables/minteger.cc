@@ -17,21 +17,26 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <functional>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "moriarty/constraints/equality_constraints.h"
 #include "moriarty/constraints/integer_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
 #include "moriarty/constraints/size_constraints.h"
+#include "moriarty/context.h"
 #include "moriarty/contexts/librarian_context.h"
+#include "moriarty/internal/generation_handler.h"
 #include "moriarty/internal/range.h"
 #include "moriarty/librarian/errors.h"
 #include "moriarty/librarian/policies.h"
@@ -148,8 +153,13 @@ std::optional<int64_t> MInteger::GetUniqueValueImpl(
 
 Range::ExtremeValues<int64_t> MInteger::GetExtremeValues(
     librarian::GenerateVariableContext ctx) const {
+  // The same bounds are often resolved many times per generation (e.g., for
+  // each element of an array), so they are cached.
+  const Range& bounds = core_constraints_.Bounds();
+  if (auto cached = ctx.GetCachedIntegerExtremes(bounds)) return *cached;
+
   std::optional<Range::ExtremeValues<int64_t>> extremes =
-      core_constraints_.Bounds().IntegerExtremes([&](std::string_view var) {
+      bounds.IntegerExtremes([&](std::string_view var) {
         return ctx.GenerateVariable<MInteger>(var);
       });
   if (!extremes) {
@@ -157,22 +167,14 @@ Range::ExtremeValues<int64_t> MInteger::GetExtremeValues(
                           std::format("No integer satisfies: {}", ToString()),
                           RetryPolicy::kAbort);
   }
+  ctx.CacheIntegerExtremes(bounds, *extremes);
   return *extremes;
 }
 
 std::optional<Range::ExtremeValues<int64_t>> MInteger::GetExtremeValues(
     librarian::AnalyzeVariableContext ctx) const {
-  try {
-    std::optional<Range::ExtremeValues<int64_t>> extremes =
-        core_constraints_.Bounds().IntegerExtremes([&](std::string_view var) {
-          auto value = ctx.GetUniqueValue<MInteger>(var);
-          if (!value) throw ValueNotFound(var);
-          return *value;
-        });
-    return extremes;
-  } catch (const ValueNotFound& e) {
-    return std::nullopt;
-  }
+  return core_constraints_.Bounds().IntegerExtremesIfKnown(
+      [&](std::string_view var) { return ctx.GetUniqueValue<MInteger>(var); });
 }
 
 namespace {
@@ -198,11 +200,9 @@ Range::ExtremeValues<int64_t> GetExtremesForSize(
   return rng_extremes.value_or(extremes);
 }
 
-int64_t HandleModdedGeneration(
-    librarian::GenerateVariableContext ctx,
-    const Range::ExtremeValues<int64_t>& original_extremes,
-    const Range::ExtremeValues<int64_t>& size_adjusted_extremes,
-    const Mod::Equation& m) {
+// Resolves `m` into a (modulus, non-negative remainder) pair.
+std::pair<int64_t, int64_t> ResolveMod(librarian::GenerateVariableContext ctx,
+                                       const Mod::Equation& m) {
   int64_t mod = ctx.ResolveExpression(m.modulus);
   if (mod <= 0) {
     throw GenerationError(
@@ -212,25 +212,35 @@ int64_t HandleModdedGeneration(
   }
   int64_t remainder = ctx.ResolveExpression(m.remainder) % mod;
   if (remainder < 0) remainder += mod;
+  return {mod, remainder};
+}
 
-  auto clamp_extremes =
-      [](Range::ExtremeValues<int64_t> extremes, int64_t mod,
-         int64_t remainder) -> std::optional<Range::ExtremeValues<int64_t>> {
-    int64_t first_candidate =
-        extremes.min + ((remainder - (extremes.min % mod) + mod) % mod);
-    if (first_candidate > extremes.max) {
-      return std::nullopt;
-    }
-    int64_t last_candidate =
-        extremes.max - ((extremes.max % mod - remainder + mod) % mod);
-    return Range::ExtremeValues<int64_t>{first_candidate, last_candidate};
-  };
+// Returns the smallest and largest values in `extremes` that are congruent to
+// `remainder` (mod `mod`), or std::nullopt if there are none.
+std::optional<Range::ExtremeValues<int64_t>> ClampToMod(
+    Range::ExtremeValues<int64_t> extremes, int64_t mod, int64_t remainder) {
+  int64_t first_candidate =
+      extremes.min + ((remainder - (extremes.min % mod) + mod) % mod);
+  if (first_candidate > extremes.max) {
+    return std::nullopt;
+  }
+  int64_t last_candidate =
+      extremes.max - ((extremes.max % mod - remainder + mod) % mod);
+  return Range::ExtremeValues<int64_t>{first_candidate, last_candidate};
+}
+
+int64_t HandleModdedGeneration(
+    librarian::GenerateVariableContext ctx,
+    const Range::ExtremeValues<int64_t>& original_extremes,
+    const Range::ExtremeValues<int64_t>& size_adjusted_extremes,
+    const Mod::Equation& m) {
+  auto [mod, remainder] = ResolveMod(ctx, m);
 
   auto get_extremes = [&]() {
-    auto size_extremes = clamp_extremes(size_adjusted_extremes, mod, remainder);
+    auto size_extremes = ClampToMod(size_adjusted_extremes, mod, remainder);
     if (size_extremes) return *size_extremes;
 
-    auto orig_extremes = clamp_extremes(original_extremes, mod, remainder);
+    auto orig_extremes = ClampToMod(original_extremes, mod, remainder);
     if (orig_extremes) return *orig_extremes;
 
     throw GenerationError(ctx.GetLocalVariableName(),
@@ -243,6 +253,56 @@ int64_t HandleModdedGeneration(
   return mmin + mod * ctx.RandomInteger(num_candidates);
 }
 
+// Every integer up to 2^53 is exactly representable as a double.
+constexpr int64_t kMaxExactDoubleInteger = int64_t{1} << 53;
+
+// LazyPermutation
+//
+// Produces a uniformly random permutation of {0, 1, ... , n-1} one element at
+// a time (a Fisher-Yates shuffle that is only performed as far as needed).
+// If `n` is small relative to `expected_draws`, the permutation is stored
+// densely. Otherwise, only displaced positions are stored, so drawing k values
+// costs O(k) time and memory.
+class LazyPermutation {
+ public:
+  LazyPermutation(int64_t n, int64_t expected_draws)
+      : n_(n), dense_(n <= 4 * expected_draws) {
+    if (dense_) {
+      values_.resize(n);
+      for (int64_t i = 0; i < n; i++) values_[i] = i;
+    }
+  }
+
+  bool HasNext() const { return next_ < n_; }
+
+  int64_t Next(librarian::GenerateVariableContext& ctx) {
+    int64_t j = ctx.RandomInteger(next_, n_ - 1);
+    int64_t result;
+    if (dense_) {
+      std::swap(values_[next_], values_[j]);
+      result = values_[next_];
+    } else {
+      result = ValueAt(j);
+      if (j != next_) displaced_[j] = ValueAt(next_);
+      displaced_.erase(next_);
+    }
+    next_++;
+    return result;
+  }
+
+ private:
+  int64_t n_;
+  int64_t next_ = 0;
+  bool dense_;
+  std::vector<int64_t> values_;
+  absl::flat_hash_map<int64_t, int64_t> displaced_;
+
+  int64_t ValueAt(int64_t idx) const {
+    auto it = displaced_.find(idx);
+    return it == displaced_.end() ? idx : it->second;
+  }
+};
+
 }  // namespace
 
 int64_t MInteger::GenerateImpl(librarian::GenerateVariableContext ctx) const {
@@ -283,6 +343,138 @@ int64_t MInteger::GenerateImpl(librarian::GenerateVariableContext ctx) const {
                            size_adjusted_extremes.max);
 }
 
+auto MInteger::GetCandidateValues(librarian::GenerateVariableContext ctx) const
+    -> std::optional<CandidateValues> {
+  if (numeric_one_of_->HasBeenConstrained() ||
+      size_handler_->GetConstrainedSize() != CommonSize::kAny) {
+    return std::nullopt;
+  }
+
+  Range::ExtremeValues<int64_t> extremes = GetExtremeValues(ctx);
+  int64_t step = 1;
+  if (core_constraints_.ModConstrained()) {
+    auto [mod, remainder] =
+        ResolveMod(ctx, core_constraints_.ModConstraints());
+    auto clamped = ClampToMod(extremes, mod, remainder);
+    if (!clamped) {
+      throw GenerationError(ctx.GetLocalVariableName(),
+                            "Cannot find a value with the correct mod value",
+                            RetryPolicy::kAbort);
+    }
+    extremes = *clamped;
+    step = mod;
+  }
+
+  uint64_t max_index = (static_cast<uint64_t>(extremes.max) -
+                        static_cast<uint64_t>(extremes.min)) /
+                       static_cast<uint64_t>(step);
+  // Ranges with 2^63 or more candidates do not fit in `count`. For those, the
+  // callers fall back to independent draws: rejection sampling for distinct
+  // values (collisions are vanishingly rare at that size) and sorting for
+  // sorted values.
+  if (max_index >= std::numeric_limits<int64_t>::max()) return std::nullopt;
+
+  // Some dependent variables may not have been generated, but are required to
+  // validate. Generate them now.
+  for (std::string_view dep : GetDependencies()) ctx.AssignVariable(dep);
+
+  return CandidateValues{.min = extremes.min,
+                         .step = step,
+                         .count = static_cast<int64_t>(max_index) + 1};
+}
+
+std::optional<std::vector<int64_t>> MInteger::GenerateDistinctValues(
+    librarian::GenerateVariableContext ctx, int n) const {
+  std::optional<CandidateValues> candidates = GetCandidateValues(ctx);
+  if (!candidates) return std::nullopt;
+  ConstraintContext validation_ctx(ctx);
+
+  // Candidates that fail validation (e.g., custom constraints) are skipped.
+  // This bounds the work done if almost no candidates are valid.
+  int64_t remaining_rejections =
+      moriarty_internal::GenerationHandler::kDefaultMaxActiveRetries *
+      std::max(n, 1);
+
+  std::vector<int64_t> values;
+  values.reserve(n);
+  LazyPermutation permutation(candidates->count, n);
+  while (values.size() < n && permutation.HasNext()) {
+    int64_t value = candidates->min + candidates->step * permutation.Next(ctx);
+    if (Validate(validation_ctx, value).IsOk()) {
+      values.push_back(value);
+    } else if (--remaining_rejections < 0) {
+      break;
+    }
+  }
+
+  return values;
+}
+
+std::optional<std::vector<int64_t>> MInteger::GenerateSortedValues(
+    librarian::GenerateVariableContext ctx, int n) const {
+  std::optional<CandidateValues> candidates = GetCandidateValues(ctx);
+  if (!candidates) return std::nullopt;
+
+  std::vector<int64_t> indices;
+  indices.reserve(n);
+  if (candidates->count <= kMaxExactDoubleInteger) {
+    // The k-th smallest of n independent uniform reals in [0, 1) is
+    // distributed as S_k / S_{n+1}, where S_k is the sum of the first k of
+    // n+1 independent exponential random variables. This lets us produce the
+    // order statistics in increasing order without sorting.
+    std::vector<double> prefix_sums;
+    prefix_sums.reserve(n);
+    double total = 0;
+    auto exponential = [&]() { return -std::log1p(-ctx.RandomReal(1.0)); };
+    for (int i = 0; i < n; i++) prefix_sums.push_back(total += exponential());
+    total += exponential();
+
+    double count = static_cast<double>(candidates->count);
+    for (double sum : prefix_sums) {
+      int64_t index = static_cast<int64_t>(sum / total * count);
+      indices.push_back(std::min(index, candidates->count - 1));
+    }
+  } else {
+    for (int i = 0; i < n; i++)
+      indices.push_back(ctx.RandomInteger(candidates->count));
+    std::ranges::sort(indices);
+  }
+
+  ConstraintContext validation_ctx(ctx);
+  std::vector<int64_t> values;
+  values.reserve(n);
+  for (int64_t index : indices) {
+    int64_t value = candidates->min + candidates->step * index;
+    // Rejecting the whole array (rather than individual values) keeps the
+    // values distributed as independent samples conditioned on validity.
+    if (!Validate(validation_ctx, value).IsOk()) return std::nullopt;
+    values.push_back(value);
+  }
+  return values;
+}
+
+std::optional<size_t> MInteger::FindInvalidValue(
+    ConstraintContext ctx, std::span<const int64_t> values) const {
+  auto first_invalid = [&]() -> std::optional<size_t> {
+    for (size_t i = 0; i < values.size(); i++)
+      if (!Validate(ctx, values[i]).IsOk()) return i;
+    return std::nullopt;
+  };
+
+  if (values.empty() || HasCustomConstraints() ||
+      core_constraints_.ModConstrained() ||
+      numeric_one_of_->HasBeenConstrained()) {
+    return first_invalid();
+  }
+
+  // The remaining constraints are all intervals, and so is their intersection.
+  // If both extremes are valid, everything between them is as well.
+  auto [min, max] = std::ranges::minmax(values);
+  if (Validate(ctx, min).IsOk() && Validate(ctx, max).IsOk())
+    return std::nullopt;
+  return first_invalid();
+}
+
 int64_t MInteger::ReadImpl(librarian::ReadVariableContext ctx) const {
   return ctx.ReadInteger();
 }
@@ -16,8 +16,10 @@
 #ifndef MORIARTY_VARIABLES_MINTEGER_H_
 #define MORIARTY_VARIABLES_MINTEGER_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -101,6 +103,43 @@ class MInteger : public librarian::MVariable<MInteger> {
 
   [[nodiscard]] std::string Typename() const override { return "MInteger"; }
 
+  // GenerateDistinctValues()
+  //
+  // Returns `n` distinct values (in random order) that each satisfy all
+  // constraints on this variable. Values are sampled without replacement
+  // directly from the resolved range (respecting `Mod`), so this takes O(n)
+  // expected time even if `n` is the size of the range. If fewer than `n`
+  // valid values can be found, all of the ones found are returned.
+  //
+  // Returns std::nullopt if the constraints cannot be sampled directly (e.g.,
+  // `OneOf` or `SizeCategory`). Callers should fall back to calling
+  // `Generate()` repeatedly in that case.
+  [[nodiscard]] std::optional<std::vector<int64_t>> GenerateDistinctValues(
+      librarian::GenerateVariableContext ctx, int n) const;
+
+  // GenerateSortedValues()
+  //
+  // Returns `n` values in non-decreasing order, distributed as if `n` values
+  // were generated independently and then sorted. For most ranges, the values
+  // are produced in order directly, so this takes O(n) time.
+  //
+  // Returns std::nullopt if the constraints cannot be sampled directly (e.g.,
+  // `OneOf` or `SizeCategory`) or if a sampled value does not satisfy all
+  // constraints (e.g., custom constraints). Callers should fall back to
+  // calling `Generate()` repeatedly in that case.
+  [[nodiscard]] std::optional<std::vector<int64_t>> GenerateSortedValues(
+      librarian::GenerateVariableContext ctx, int n) const;
+
+  // FindInvalidValue()
+  //
+  // Returns the index of the first value in `values` that does not satisfy all
+  // constraints on this variable, or std::nullopt if all of them do. This is
+  // equivalent to calling `Validate()` on each value, but if the constraints
+  // restrict the value to an interval, only the smallest and largest values
+  // are validated.
+  [[nodiscard]] std::optional<size_t> FindInvalidValue(
+      ConstraintContext ctx, std::span<const int64_t> values) const;
+
   // MInteger::CoreConstraints
   //
   // A base set of constraints for `MInteger` that are used during generation.
@@ -147,6 +186,19 @@ class MInteger : public librarian::MVariable<MInteger> {
   Range::ExtremeValues<int64_t> GetExtremeValues(
       librarian::GenerateVariableContext ctx) const;
 
+  // The values `min + step * i` for `0 <= i < count`.
+  struct CandidateValues {
+    int64_t min;
+    int64_t step;
+    int64_t count;
+  };
+
+  // Returns all values this variable may take (ignoring custom constraints),
+  // or std::nullopt if they cannot be described this way (e.g., `OneOf` or
+  // `SizeCategory`). Generates all dependent variables along the way.
+  std::optional<CandidateValues> GetCandidateValues(
+      librarian::GenerateVariableContext ctx) const;
+
   // ---------------------------------------------------------------------------
   //  MVariable overrides
   int64_t GenerateImpl(librarian::GenerateVariableContext ctx) const override;
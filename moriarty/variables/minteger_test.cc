@@ -549,5 +549,31 @@ TEST(MIntegerTest, ModShouldGenerateDependentVariablesNoValueKnown) {
               GeneratedValuesAre(AnyOf(15, 16), context));
 }
 
+TEST(MIntegerTest, FindInvalidValueReturnsTheFirstInvalidIndex) {
+  moriarty_internal::ValueSet values;
+  moriarty_internal::VariableSet variables;
+  ConstraintContext ctx("_", variables, values);
+
+  EXPECT_EQ(MInteger(Between(1, 10)).FindInvalidValue(ctx, {}), std::nullopt);
+  EXPECT_EQ(MInteger(Between(1, 10)).FindInvalidValue(ctx, {{1, 10, 5}}),
+            std::nullopt);
+  EXPECT_THAT(MInteger(Between(1, 10)).FindInvalidValue(ctx, {{3, 11, 0, 12}}),
+              Optional(1));
+  EXPECT_THAT(MInteger(AtLeast(0), AtMost(5))
+                  .FindInvalidValue(ctx, {{0, 5, 1, -1}}),
+              Optional(3));
+  EXPECT_THAT(MInteger(Between(1, 10), Mod(0, 2))
+                  .FindInvalidValue(ctx, {{2, 10, 5, 4}}),
+              Optional(2));
+  EXPECT_THAT(
+      MInteger(OneOf({1, 3, 5})).FindInvalidValue(ctx, {{1, 5, 3, 2, 3}}),
+      Optional(3));
+  EXPECT_THAT(MInteger(Between(1, 10))
+                  .AddCustomConstraint("NotSeven",
+                                       [](int64_t x) { return x != 7; })
+                  .FindInvalidValue(ctx, {{1, 10, 7, 9}}),
+              Optional(2));
+}
+
 }  // namespace
 }  // namespace moriarty
@@ -0,0 +1,34 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/variables/mmatrix.h"
+
+#include "moriarty/librarian/io_config.h"
+
+namespace moriarty {
+
+MMatrixFormat& MMatrixFormat::WithSeparator(Whitespace separator) {
+  separator_ = separator;
+  return *this;
+}
+
+Whitespace MMatrixFormat::GetSeparator() const { return separator_; }
+
+void MMatrixFormat::Merge(const MMatrixFormat& other) {
+  if (other.separator_ != Whitespace::kSpace) {
+    separator_ = other.separator_;
+  }
+}
+
+}  // namespace moriarty
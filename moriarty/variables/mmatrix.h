@@ -0,0 +1,515 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MORIARTY_VARIABLES_MMATRIX_H_
+#define MORIARTY_VARIABLES_MMATRIX_H_
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "moriarty/constraints/container_constraints.h"
+#include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/constraints/matrix_constraints.h"
+#include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/contexts/librarian_context.h"
+#include "moriarty/librarian/errors.h"
+#include "moriarty/librarian/io_config.h"
+#include "moriarty/librarian/mvariable.h"
+#include "moriarty/librarian/policies.h"
+#include "moriarty/librarian/util/cow_ptr.h"
+#include "moriarty/librarian/util/ref.h"
+#include "moriarty/types/matrix.h"
+#include "moriarty/variables/minteger.h"
+
+namespace moriarty {
+
+template <typename MElementType>
+class MMatrix;
+namespace librarian {
+template <typename MElementType>
+struct MVariableValueTypeTrait<MMatrix<MElementType>> {
+  using type = Matrix<typename MElementType::value_type>;
+};
+}  // namespace librarian
+
+// MMatrixFormat
+//
+// How to format an MMatrix when reading/writing. Each row is always on its own
+// line.
+class MMatrixFormat {
+ public:
+  // Sets the whitespace to be used between entries in the same row.
+  //
+  // Default: kSpace
+  MMatrixFormat& WithSeparator(Whitespace separator);
+  // Returns the whitespace used between entries in the same row.
+  Whitespace GetSeparator() const;
+
+  // Take any non-defaults in `other` and apply them to this format.
+  void Merge(const MMatrixFormat& other);
+
+ private:
+  Whitespace separator_ = Whitespace::kSpace;
+};
+
+// MMatrix<>
+//
+// Describes constraints placed on a 2-dimensional grid. The entries of the
+// matrix must have a corresponding MVariable, and general constraints on the
+// entries are controlled via the `Elements` constraint.
+//
+// Unlike `MArray<MArray<T>>`, all entries are stored in a single contiguous
+// buffer (see `Matrix<T>`).
+//
+// In order to generate, the number of rows and columns must be constrained
+// (via the `NumRows` and `NumCols` constraints).
+template <typename MElementType>
+class MMatrix : public librarian::MVariable<MMatrix<MElementType>> {
+ public:
+  using element_value_type = typename MElementType::value_type;
+  using matrix_type = Matrix<element_value_type>;
+  class Reader;  // Forward declaration
+  using chunked_reader_type = Reader;
+
+  static_assert(
+      MoriartyVariable<MElementType>,
+      "The T used in MMatrix<T> must be a Moriarty variable. For example, "
+      "MMatrix<MInteger> or MMatrix<MCustomType>.");
+
+  // Create an MMatrix from a set of constraints. Logically equivalent to
+  // calling AddConstraint() for each constraint.
+  //
+  // E.g., MMatrix<MInteger>(Elements(Between(1, 10)), NumRows(5), NumCols(7))
+  template <typename... Constraints>
+    requires(ConstraintFor<MMatrix<MElementType>, Constraints> && ...)
+  explicit MMatrix(Constraints&&... constraints);
+
+  // Create an MMatrix with this set of constraints on each entry.
+  explicit MMatrix(MElementType element_constraints);
+
+  ~MMatrix() override = default;
+
+  using librarian::MVariable<MMatrix>::AddConstraint;  // Custom constraints
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the value to a specific set of values
+
+  // The matrix must have exactly this value.
+  MMatrix& AddConstraint(Exactly<matrix_type> constraint);
+  // The matrix must be one of these values.
+  MMatrix& AddConstraint(OneOf<matrix_type> constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the dimensions of the matrix
+
+  // The matrix must have this many rows.
+  MMatrix& AddConstraint(NumRows constraint);
+  // The matrix must have this many columns.
+  MMatrix& AddConstraint(NumCols constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the entries of the matrix
+
+  // The matrix's entries must satisfy these constraints.
+  template <typename... MConstraints>
+  MMatrix& AddConstraint(Elements<MConstraints...> constraint);
+  // The matrix's entries must satisfy these constraints.
+  MMatrix& AddConstraint(StronglyTypedElements<MElementType> constraint);
+
+  // ---------------------------------------------------------------------------
+  //  Constrain the matrix's I/O
+
+  // Change the I/O format of the matrix.
+  MMatrix& AddConstraint(MMatrixFormat constraint);
+  // Returns the I/O format for this matrix.
+  [[nodiscard]] MMatrixFormat& Format();
+  // Returns the I/O format for this matrix.
+  [[nodiscard]] MMatrixFormat Format() const;
+
+  // Typename()
+  //
+  // Returns a string representing the name of this type (for example,
+  // "MMatrix<MInteger>"). This is mostly used for debugging/error messages.
+  [[nodiscard]] std::string Typename() const override;
+
+  // MMatrix::Reader
+  //
+  // Reads a matrix one row at a time, without reading the newlines between
+  // rows. Call ReadNext() once per row, then call Finalize() to get the final
+  // value, which will leave this in a moved-from-state.
+  class Reader {
+   public:
+    explicit Reader(librarian::ReadVariableContext ctx, int num_chunks,
+                    Ref<const MMatrix> variable);
+    void ReadNext(librarian::ReadVariableContext ctx);
+    matrix_type Finalize() &&;
+
+   private:
+    int64_t num_rows_;
+    int64_t num_cols_;
+    std::vector<element_value_type> entries_;
+    Ref<const MMatrix> variable_;
+  };
+
+  // MMatrix::CoreConstraints
+  //
+  // A base set of constraints for `MMatrix` that are used during generation.
+  // Note: Returned references are invalidated after any non-const call to this
+  // class or the corresponding `MMatrix`.
+  class CoreConstraints {
+   public:
+    // Returns all constraints on the entries of the matrix.
+    [[nodiscard]] const MElementType& Elements() const;
+    // Returns whether the entries have been constrained.
+    [[nodiscard]] bool ElementsConstrained() const;
+
+    // Returns all constraints on how many rows are in the matrix.
+    [[nodiscard]] const MInteger& NumRows() const;
+    // Returns whether the number of rows has been constrained.
+    [[nodiscard]] bool NumRowsConstrained() const;
+
+    // Returns all constraints on how many columns are in the matrix.
+    [[nodiscard]] const MInteger& NumCols() const;
+    // Returns whether the number of columns has been constrained.
+    [[nodiscard]] bool NumColsConstrained() const;
+
+   private:
+    friend class MMatrix;
+    enum Flags : uint32_t {
+      kElements = 1 << 0,
+      kNumRows = 1 << 1,
+      kNumCols = 1 << 2,
+    };
+    struct Data {
+      std::underlying_type_t<Flags> touched = 0;
+
+      MElementType elements;
+      MInteger num_rows;
+      MInteger num_cols;
+    };
+    librarian::CowPtr<Data> data_;
+    bool IsSet(Flags flag) const;
+  };
+  [[nodiscard]] CoreConstraints GetCoreConstraints() const {
+    return core_constraints_;
+  }
+
+ private:
+  CoreConstraints core_constraints_;
+  MMatrixFormat format_;
+
+  // Reads `num_cols` entries separated by `Format().GetSeparator()` and
+  // appends them to `entries`. If `validate_integers` is false, integer entries
+  // are not validated, and the caller must validate the whole matrix
+  // afterwards. Otherwise, integer rows are validated all at once instead of
+  // one entry at a time.
+  void ReadRow(librarian::ReadVariableContext ctx, int64_t num_cols,
+               std::vector<element_value_type>& entries,
+               bool validate_integers) const;
+
+  // Writes the entries of `row` separated by `Format().GetSeparator()`.
+  void WriteRow(librarian::WriteVariableContext ctx,
+                std::span<const element_value_type> row) const;
+
+  // ---------------------------------------------------------------------------
+  //  MVariable overrides
+  matrix_type GenerateImpl(
+      librarian::GenerateVariableContext ctx) const override;
+  matrix_type ReadImpl(librarian::ReadVariableContext ctx) const override;
+  void WriteImpl(librarian::WriteVariableContext ctx,
+                 const matrix_type& value) const override;
+  // ---------------------------------------------------------------------------
+};
+
+// Class template argument deduction (CTAD). Allows for `MMatrix(MInteger())`
+// instead of `MMatrix<MInteger>(MInteger())`.
+template <typename MoriartyElementType>
+MMatrix(MoriartyElementType) -> MMatrix<MoriartyElementType>;
+
+// -----------------------------------------------------------------------------
+//  Template Implementation Below
+
+template <typename T>
+MMatrix<T>::MMatrix(T element_constraints)
+    : MMatrix<T>(StronglyTypedElements<T>(std::move(element_constraints))) {}
+
+template <typename T>
+template <typename... Constraints>
+  requires(ConstraintFor<MMatrix<T>, Constraints> && ...)
+MMatrix<T>::MMatrix(Constraints&&... constraints) {
+  (AddConstraint(std::forward<Constraints>(constraints)), ...);
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(Exactly<matrix_type> constraint) {
+  return this->InternalAddExactlyConstraint(std::move(constraint));
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(OneOf<matrix_type> constraint) {
+  return this->InternalAddOneOfConstraint(std::move(constraint));
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(NumRows constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kNumRows;
+  constraints.num_rows.MergeFrom(constraint.GetConstraints());
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(NumCols constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kNumCols;
+  constraints.num_cols.MergeFrom(constraint.GetConstraints());
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename T>
+template <typename... MConstraints>
+MMatrix<T>& MMatrix<T>::AddConstraint(Elements<MConstraints...> constraint) {
+  (librarian::AssertIsConstraintForType<T, MConstraints>(), ...);
+  return AddConstraint(StronglyTypedElements<T>(std::move(constraint)));
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(StronglyTypedElements<T> constraint) {
+  auto& constraints = core_constraints_.data_.Mutable();
+  constraints.touched |= CoreConstraints::Flags::kElements;
+  constraints.elements.MergeFrom(constraint.GetConstraints());
+  return this->InternalAddConstraint(std::move(constraint));
+}
+
+template <typename T>
+MMatrix<T>& MMatrix<T>::AddConstraint(MMatrixFormat constraint) {
+  Format().Merge(std::move(constraint));
+  return *this;
+}
+
+template <typename T>
+MMatrixFormat& MMatrix<T>::Format() {
+  return format_;
+}
+
+template <typename T>
+MMatrixFormat MMatrix<T>::Format() const {
+  return format_;
+}
+
+template <typename T>
+std::string MMatrix<T>::Typename() const {
+  return std::format("MMatrix<{}>", core_constraints_.Elements().Typename());
+}
+
+template <typename MElementType>
+auto MMatrix<MElementType>::GenerateImpl(
+    librarian::GenerateVariableContext ctx) const -> matrix_type {
+  if (this->GetOneOf().HasBeenConstrained())
+    return this->GetOneOf().SelectOneOf(
+        [&](int n) { return ctx.RandomInteger(n); });
+
+  if (!core_constraints_.NumRowsConstrained() ||
+      !core_constraints_.NumColsConstrained()) {
+    throw GenerationError(ctx.GetLocalVariableName(),
+                          "Attempting to generate a matrix without both the "
+                          "number of rows and columns given.",
+                          RetryPolicy::kAbort);
+  }
+
+  MInteger num_rows_local = core_constraints_.NumRows();
+  num_rows_local.AddConstraint(AtLeast(0));
+  int64_t num_rows = num_rows_local.Generate(ctx.ForSubVariable("num_rows"));
+
+  MInteger num_cols_local = core_constraints_.NumCols();
+  num_cols_local.AddConstraint(AtLeast(0));
+  int64_t num_cols = num_cols_local.Generate(ctx.ForSubVariable("num_cols"));
+
+  std::vector<element_value_type> entries;
+  entries.reserve(num_rows * num_cols);
+  auto entry_name = [num_cols](int idx) {
+    return std::format("entry ({}, {})", idx / num_cols, idx % num_cols);
+  };
+  for (int64_t i = 0; i < num_rows * num_cols; i++) {
+    entries.push_back(core_constraints_.Elements().Generate(
+        ctx.ForIndexedSubVariable(entry_name, i)));
+  }
+  return matrix_type(num_rows, num_cols, std::move(entries));
+}
+
+template <typename MElementType>
+void MMatrix<MElementType>::ReadRow(
+    librarian::ReadVariableContext ctx, int64_t num_cols,
+    std::vector<element_value_type>& entries, bool validate_integers) const {
+  Whitespace separator = Format().GetSeparator();
+  if constexpr (std::same_as<MElementType, MInteger>) {
+    size_t row_start = entries.size();
+    for (int64_t c = 0; c < num_cols; c++) {
+      if (c > 0) ctx.ReadWhitespace(separator);
+      entries.push_back(ctx.ReadInteger());
+    }
+    if (!validate_integers) return;
+
+    std::span<const int64_t> row = std::span(entries).subspan(row_start);
+    const MInteger& elements = core_constraints_.Elements();
+    if (std::optional<size_t> invalid =
+            elements.FindInvalidValue(ConstraintContext(ctx), row)) {
+      auto v = elements.Validate(ConstraintContext(ctx), row[*invalid]);
+      ctx.ThrowIOErrorWithContext(
+          std::format("entry ({}, {}) violates constraint",
+                      row_start / num_cols, *invalid),
+          v.PrettyReason());
+    }
+  } else {
+    for (int64_t c = 0; c < num_cols; c++) {
+      if (c > 0) ctx.ReadWhitespace(separator);
+      entries.push_back(core_constraints_.Elements().Read(ctx));
+    }
+  }
+}
+
+template <typename MElementType>
+auto MMatrix<MElementType>::ReadImpl(librarian::ReadVariableContext ctx) const
+    -> matrix_type {
+  std::optional<int64_t> num_rows =
+      core_constraints_.NumRows().GetUniqueValue(ctx);
+  if (!num_rows)
+    ctx.ThrowIOError("Cannot determine the number of rows before read.");
+  std::optional<int64_t> num_cols =
+      core_constraints_.NumCols().GetUniqueValue(ctx);
+  if (!num_cols)
+    ctx.ThrowIOError("Cannot determine the number of columns before read.");
+
+  std::vector<element_value_type> entries;
+  entries.reserve(*num_rows * *num_cols);
+  for (int64_t r = 0; r < *num_rows; r++) {
+    if (r > 0) ctx.ReadWhitespace(Whitespace::kNewline);
+    ReadRow(ctx, *num_cols, entries, /*validate_integers=*/false);
+  }
+  // The entries are validated by `Read()` once the whole value is known.
+  return matrix_type(*num_rows, *num_cols, std::move(entries));
+}
+
+template <typename MElementType>
+void MMatrix<MElementType>::WriteRow(
+    librarian::WriteVariableContext ctx,
+    std::span<const element_value_type> row) const {
+  if constexpr (std::same_as<MElementType, MInteger>) {
+    // Format the whole row at once instead of one token at a time.
+    char separator = WhitespaceAsChar(Format().GetSeparator());
+    std::string line;
+    line.reserve(row.size() * 4);
+    char buffer[24];
+    for (size_t c = 0; c < row.size(); c++) {
+      if (c > 0) line.push_back(separator);
+      auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), row[c]);
+      line.append(buffer, end);
+    }
+    ctx.WriteToken(line);
+  } else {
+    for (size_t c = 0; c < row.size(); c++) {
+      if (c > 0) ctx.WriteWhitespace(Format().GetSeparator());
+      core_constraints_.Elements().Write(ctx, row[c]);
+    }
+  }
+}
+
+template <typename MElementType>
+void MMatrix<MElementType>::WriteImpl(librarian::WriteVariableContext ctx,
+                                      const matrix_type& value) const {
+  for (int64_t r = 0; r < value.NumRows(); r++) {
+    if (r > 0) ctx.WriteWhitespace(Whitespace::kNewline);
+    WriteRow(ctx, value.Row(r));
+  }
+}
+
+// ====== MMatrix::Reader ======
+template <typename MElementType>
+MMatrix<MElementType>::Reader::Reader(librarian::ReadVariableContext ctx,
+                                      int num_chunks,
+                                      Ref<const MMatrix> variable)
+    : num_rows_(num_chunks), variable_(variable) {
+  const CoreConstraints& constraints = variable_.get().GetCoreConstraints();
+  std::optional<int64_t> num_rows = constraints.NumRows().GetUniqueValue(ctx);
+  if (num_rows && *num_rows != num_chunks) {
+    ctx.ThrowIOError("MMatrix::Reader expected to read {} rows, but got {}.",
+                     *num_rows, num_chunks);
+  }
+  std::optional<int64_t> num_cols = constraints.NumCols().GetUniqueValue(ctx);
+  if (!num_cols)
+    ctx.ThrowIOError("Cannot determine the number of columns before read.");
+  num_cols_ = *num_cols;
+  entries_.reserve(num_rows_ * num_cols_);
+}
+
+template <typename MElementType>
+void MMatrix<MElementType>::Reader::ReadNext(
+    librarian::ReadVariableContext ctx) {
+  variable_.get().ReadRow(ctx, num_cols_, entries_, /*validate_integers=*/true);
+}
+
+template <typename MElementType>
+auto MMatrix<MElementType>::Reader::Finalize() && -> matrix_type {
+  return matrix_type(num_rows_, num_cols_, std::move(entries_));
+}
+
+// ====== MMatrix::CoreConstraints ======
+template <typename MElementType>
+const MElementType& MMatrix<MElementType>::CoreConstraints::Elements() const {
+  return data_->elements;
+}
+
+template <typename MElementType>
+bool MMatrix<MElementType>::CoreConstraints::ElementsConstrained() const {
+  return IsSet(Flags::kElements);
+}
+
+template <typename MElementType>
+const MInteger& MMatrix<MElementType>::CoreConstraints::NumRows() const {
+  return data_->num_rows;
+}
+
+template <typename MElementType>
+bool MMatrix<MElementType>::CoreConstraints::NumRowsConstrained() const {
+  return IsSet(Flags::kNumRows);
+}
+
+template <typename MElementType>
+const MInteger& MMatrix<MElementType>::CoreConstraints::NumCols() const {
+  return data_->num_cols;
+}
+
+template <typename MElementType>
+bool MMatrix<MElementType>::CoreConstraints::NumColsConstrained() const {
+  return IsSet(Flags::kNumCols);
+}
+
+template <typename MElementType>
+bool MMatrix<MElementType>::CoreConstraints::IsSet(Flags flag) const {
+  return (data_->touched & static_cast<std::underlying_type_t<Flags>>(flag)) !=
+         0;
+}
+
+}  // namespace moriarty
+
+#endif  // MORIARTY_VARIABLES_MMATRIX_H_
@@ -0,0 +1,268 @@
+// Copyright 2025 Darcy Best
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "moriarty/variables/mmatrix.h"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "moriarty/constraints/container_constraints.h"
+#include "moriarty/constraints/equality_constraints.h"
+#include "moriarty/constraints/integer_constraints.h"
+#include "moriarty/constraints/matrix_constraints.h"
+#include "moriarty/constraints/numeric_constraints.h"
+#include "moriarty/constraints/string_constraints.h"
+#include "moriarty/context.h"
+#include "moriarty/contexts/librarian_context.h"
+#include "moriarty/librarian/errors.h"
+#include "moriarty/librarian/io_config.h"
+#include "moriarty/librarian/testing/gtest_helpers.h"
+#include "moriarty/simple_io.h"
+#include "moriarty/test_case.h"
+#include "moriarty/types/matrix.h"
+#include "moriarty/variables/minteger.h"
+#include "moriarty/variables/mstring.h"
+
+namespace moriarty {
+namespace {
+
+using ::moriarty_testing::Context;
+using ::moriarty_testing::GeneratedValuesAre;
+using ::moriarty_testing::GenerateThrowsGenerationError;
+using ::moriarty_testing::IsNotSatisfiedWith;
+using ::moriarty_testing::IsSatisfiedWith;
+using ::moriarty_testing::Read;
+using ::moriarty_testing::Write;
+using ::testing::AllOf;
+using ::testing::Each;
+using ::testing::Ge;
+using ::testing::HasSubstr;
+using ::testing::Le;
+using ::testing::ThrowsMessage;
+using ::testing::Truly;
+
+MATCHER_P2(HasShape, num_rows, num_cols, "") {
+  return arg.NumRows() == num_rows && arg.NumCols() == num_cols;
+}
+
+MATCHER_P(EntriesAre, matcher, "") {
+  return ::testing::ExplainMatchResult(matcher, arg.Entries(), result_listener);
+}
+
+Matrix<int64_t> Matrix1() { return Matrix<int64_t>({{1, 2, 3}, {4, 5, 6}}); }
+
+TEST(MMatrixTest, TypenameIsCorrect) {
+  EXPECT_EQ(MMatrix(MInteger()).Typename(), "MMatrix<MInteger>");
+  EXPECT_EQ(MMatrix(MString()).Typename(), "MMatrix<MString>");
+}
+
+TEST(MMatrixTest, WriteShouldSucceed) {
+  EXPECT_EQ(Write(MMatrix(MInteger()), Matrix1()), "1 2 3\n4 5 6");
+  EXPECT_EQ(Write(MMatrix(MInteger()), Matrix<int64_t>(1, 1, -7)), "-7");
+  EXPECT_EQ(Write(MMatrix<MString>(),
+                  Matrix<std::string>({{"ab", "c"}, {"d", "ef"}})),
+            "ab c\nd ef");
+}
+
+TEST(MMatrixTest, WriteWithSeparatorShouldSucceed) {
+  EXPECT_EQ(Write(MMatrix<MInteger>(MMatrixFormat().WithSeparator(
+                      Whitespace::kTab)),
+                  Matrix1()),
+            "1\t2\t3\n4\t5\t6");
+}
+
+TEST(MMatrixTest, ReadShouldSucceed) {
+  EXPECT_EQ(Read(MMatrix<MInteger>(NumRows(2), NumCols(3)), "1 2 3\n4 5 6"),
+            Matrix1());
+  EXPECT_EQ(Read(MMatrix<MString>(NumRows(2), NumCols(2)), "ab c\nd ef"),
+            Matrix<std::string>({{"ab", "c"}, {"d", "ef"}}));
+  EXPECT_EQ(Read(MMatrix<MInteger>(NumRows(0), NumCols(5)), ""),
+            Matrix<int64_t>(0, 5));
+}
+
+TEST(MMatrixTest, ReadWithDependentDimensionsShouldSucceed) {
+  EXPECT_EQ(Read(MMatrix<MInteger>(NumRows("N"), NumCols("M")),
+                 "1 2 3\n4 5 6",
+                 Context().WithValue<MInteger>("N", 2).WithValue<MInteger>(
+                     "M", 3)),
+            Matrix1());
+}
+
+TEST(MMatrixTest, ReadWithUnknownDimensionsShouldFail) {
+  EXPECT_THROW((void)Read(MMatrix<MInteger>(NumCols(3)), "1 2 3"), IOError);
+  EXPECT_THROW((void)Read(MMatrix<MInteger>(NumRows(1)), "1 2 3"), IOError);
+}
+
+TEST(MMatrixTest, ReadWithWrongShapeShouldFail) {
+  EXPECT_THROW(
+      (void)Read(MMatrix<MInteger>(NumRows(2), NumCols(3)), "1 2 3\n4 5"),
+      IOError);
+  EXPECT_THROW(
+      (void)Read(MMatrix<MInteger>(NumRows(2), NumCols(2)), "1 2 3\n4 5 6"),
+      IOError);
+}
+
+TEST(MMatrixTest, ReadShouldValidateEntries) {
+  EXPECT_THROW((void)Read(MMatrix<MInteger>(NumRows(2), NumCols(3),
+                                            Elements(Between(1, 5))),
+                          "1 2 3\n4 5 6"),
+               IOError);
+  EXPECT_THROW(
+      (void)Read(MMatrix<MInteger>(NumRows(2), NumCols(3),
+                                   Elements(Mod(1, 2))),
+                 "1 3 5\n7 8 9"),
+      IOError);
+}
+
+TEST(MMatrixTest, PartialReadShouldSucceed) {
+  MMatrix<MInteger> matrix(NumRows(2), NumCols(3));
+
+  Context context;
+  std::istringstream input("1 2 3\n4 5 6\n");
+  InputCursor cursor(input, WhitespaceStrictness::kPrecise);
+  librarian::ReadVariableContext ctx("A", cursor, context.Variables(),
+                                     context.Values());
+  auto reader = MMatrix<MInteger>::Reader(ctx, 2, matrix);
+
+  for (int i = 0; i < 2; i++) {
+    reader.ReadNext(ctx);
+    ASSERT_EQ(input.get(), '\n');  // Consume the separator
+  }
+  EXPECT_EQ(std::move(reader).Finalize(), Matrix1());
+}
+
+TEST(MMatrixTest, PartialReadShouldValidateEachRow) {
+  MMatrix<MInteger> matrix(NumRows(2), NumCols(3), Elements(Between(1, 5)));
+
+  Context context;
+  std::istringstream input("1 2 3\n4 5 6\n");
+  InputCursor cursor(input, WhitespaceStrictness::kPrecise);
+  librarian::ReadVariableContext ctx("A", cursor, context.Variables(),
+                                     context.Values());
+  auto reader = MMatrix<MInteger>::Reader(ctx, 2, matrix);
+  reader.ReadNext(ctx);
+  ASSERT_EQ(input.get(), '\n');
+  EXPECT_THAT([&] { reader.ReadNext(ctx); },
+              ThrowsMessage<IOError>(HasSubstr("entry (1, 2)")));
+}
+
+TEST(MMatrixTest, PartialReadWithTheWrongNumberOfRowsShouldFail) {
+  MMatrix<MInteger> matrix(NumRows(2), NumCols(3));
+
+  Context context;
+  std::istringstream input("1 2 3\n");
+  InputCursor cursor(input, WhitespaceStrictness::kPrecise);
+  librarian::ReadVariableContext ctx("A", cursor, context.Variables(),
+                                     context.Values());
+  EXPECT_THROW((void)MMatrix<MInteger>::Reader(ctx, 1, matrix), IOError);
+}
+
+TEST(MMatrixTest, SimpleIOMultilineSectionShouldRead) {
+  Context context =
+      Context()
+          .WithVariable("N", MInteger())
+          .WithVariable("A", MMatrix<MInteger>(NumRows("N"), NumCols(3)));
+
+  std::stringstream ss("2\n1 2 3\n4 5 6\n");
+  InputCursor cursor(ss, WhitespaceStrictness::kPrecise);
+  ReadContext ctx(context.Variables(), cursor);
+  ReaderFn reader =
+      SimpleIO().AddLine("N").AddMultilineSection("N", "A").Reader();
+
+  std::vector<TestCase> test_cases = reader(ctx);
+  ASSERT_EQ(test_cases.size(), 1);
+  EXPECT_EQ(test_cases[0].GetValue<MMatrix<MInteger>>("A"), Matrix1());
+}
+
+TEST(MMatrixTest, GenerateShouldRespectDimensions) {
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(3), NumCols(5)),
+              GeneratedValuesAre(HasShape(3, 5)));
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(0), NumCols(5)),
+              GeneratedValuesAre(HasShape(0, 5)));
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(Between(1, 4)), NumCols(AtMost(3))),
+              GeneratedValuesAre(
+                  Truly([](const Matrix<int64_t>& m) {
+                    return 1 <= m.NumRows() && m.NumRows() <= 4 &&
+                           0 <= m.NumCols() && m.NumCols() <= 3;
+                  })));
+}
+
+TEST(MMatrixTest, GenerateWithDependentDimensionsShouldWork) {
+  EXPECT_THAT(MMatrix<MInteger>(NumRows("N"), NumCols("2 * N")),
+              GeneratedValuesAre(HasShape(4, 8),
+                                 Context().WithValue<MInteger>("N", 4)));
+}
+
+TEST(MMatrixTest, GenerateShouldRespectElementConstraints) {
+  EXPECT_THAT(
+      MMatrix<MInteger>(NumRows(10), NumCols(10),
+                        Elements(Between(-3, 3))),
+      GeneratedValuesAre(EntriesAre(AllOf(Each(Ge(-3)), Each(Le(3))))));
+  EXPECT_THAT(MMatrix(MString(Length(2), Alphabet("ab")))
+                  .AddConstraint(NumRows(4))
+                  .AddConstraint(NumCols(4)),
+              GeneratedValuesAre(EntriesAre(Each(
+                  Truly([](const std::string& s) { return s.size() == 2; })))));
+}
+
+TEST(MMatrixTest, GenerateWithoutDimensionsShouldFail) {
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(3)),
+              GenerateThrowsGenerationError("", Context()));
+  EXPECT_THAT(MMatrix<MInteger>(NumCols(3)),
+              GenerateThrowsGenerationError("", Context()));
+}
+
+TEST(MMatrixTest, GenerateWithOneOfShouldWork) {
+  EXPECT_THAT(MMatrix<MInteger>(Exactly(Matrix1())),
+              GeneratedValuesAre(Matrix1()));
+}
+
+TEST(MMatrixTest, IsSatisfiedWithChecksDimensions) {
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(2), NumCols(3)),
+              IsSatisfiedWith(Matrix1()));
+  EXPECT_THAT(MMatrix<MInteger>(NumRows(3)),
+              IsNotSatisfiedWith(Matrix1(), "number of rows"));
+  EXPECT_THAT(MMatrix<MInteger>(NumCols(Between(4, 10))),
+              IsNotSatisfiedWith(Matrix1(), "number of columns"));
+  EXPECT_THAT(MMatrix<MInteger>(NumRows("N"), NumCols(3)),
+              IsSatisfiedWith(Matrix1(), Context().WithValue<MInteger>("N", 2)));
+}
+
+TEST(MMatrixTest, IsSatisfiedWithChecksEntries) {
+  EXPECT_THAT(MMatrix<MInteger>(Elements(Between(1, 6))),
+              IsSatisfiedWith(Matrix1()));
+  EXPECT_THAT(MMatrix<MInteger>(Elements(Between(2, 6))),
+              IsNotSatisfiedWith(Matrix1(), "entry (0, 0)"));
+  EXPECT_THAT(MMatrix<MInteger>(Elements(Between(1, 5))),
+              IsNotSatisfiedWith(Matrix1(), "entry (1, 2)"));
+  EXPECT_THAT(MMatrix<MInteger>(Elements(Mod(1, 2))),
+              IsNotSatisfiedWith(Matrix1(), "entry (0, 1)"));
+}
+
+TEST(MMatrixTest, IsSatisfiedWithChecksCustomElementConstraints) {
+  MInteger not_four = MInteger(Between(1, 6)).AddCustomConstraint(
+      "NotFour", [](int64_t x) { return x != 4; });
+
+  EXPECT_THAT(MMatrix<MInteger>(not_four),
+              IsNotSatisfiedWith(Matrix1(), "entry (1, 0)"));
+  EXPECT_THAT(MMatrix<MInteger>(not_four),
+              IsSatisfiedWith(Matrix<int64_t>({{1, 2}, {3, 5}})));
+}
+
+}  // namespace
+}  // namespace moriarty
@@ -14,9 +14,13 @@
 
 #include "moriarty/variables/mreal.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <optional>
+#include <span>
 
 #include "moriarty/constraints/equality_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
@@ -152,6 +156,35 @@ double MReal::GenerateImpl(librarian::GenerateVariableContext ctx) const {
   return ctx.RandomReal(extremes->min, extremes->max);
 }
 
+std::optional<size_t> MReal::FindInvalidValue(
+    ConstraintContext ctx, std::span<const double> values) const {
+  auto first_invalid = [&]() -> std::optional<size_t> {
+    for (size_t i = 0; i < values.size(); i++)
+      if (!Validate(ctx, values[i]).IsOk()) return i;
+    return std::nullopt;
+  };
+
+  if (values.empty() || HasCustomConstraints() ||
+      numeric_one_of_->HasBeenConstrained()) {
+    return first_invalid();
+  }
+
+  // The remaining constraints are all intervals, and so is their intersection.
+  // If both extremes are valid, everything between them is as well. NaN is
+  // not ordered, so it must be checked for separately.
+  double min = values[0];
+  double max = values[0];
+  bool has_nan = false;
+  for (double value : values) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+    has_nan |= std::isnan(value);
+  }
+  if (!has_nan && Validate(ctx, min).IsOk() && Validate(ctx, max).IsOk())
+    return std::nullopt;
+  return first_invalid();
+}
+
 double MReal::ReadImpl(librarian::ReadVariableContext ctx) const {
   return ctx.ReadReal(Format().GetDigits());
 }
@@ -170,11 +203,9 @@ std::optional<double> MReal::GetUniqueValueImpl(
   }
 
   std::optional<Range::ExtremeValues<Real>> extremes =
-      core_constraints_.Bounds().RealExtremes(
-          [&](std::string_view var) -> int64_t {
-            auto value = ctx.GetUniqueValue<MInteger>(var);
-            if (!value) throw ValueNotFound(var);
-            return *value;
+      core_constraints_.Bounds().RealExtremesIfKnown(
+          [&](std::string_view var) {
+            return ctx.GetUniqueValue<MInteger>(var);
           });
   if (!extremes || extremes->min != extremes->max) return std::nullopt;
   return extremes->min.GetApproxValue();
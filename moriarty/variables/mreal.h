@@ -17,7 +17,10 @@
 
 #include <sys/types.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
 
 #include "moriarty/constraints/equality_constraints.h"
 #include "moriarty/constraints/numeric_constraints.h"
@@ -134,6 +137,16 @@ class MReal : public librarian::MVariable<MReal> {
 
   [[nodiscard]] std::string Typename() const override { return "MReal"; }
 
+  // FindInvalidValue()
+  //
+  // Returns the index of the first value in `values` that does not satisfy all
+  // constraints on this variable, or std::nullopt if all of them do. This is
+  // equivalent to calling `Validate()` on each value, but if the constraints
+  // restrict the value to an interval, only the smallest and largest values
+  // are validated.
+  [[nodiscard]] std::optional<size_t> FindInvalidValue(
+      ConstraintContext ctx, std::span<const double> values) const;
+
   // MReal::CoreConstraints
   //
   // A base set of constraints for `MReal` that are used during generation.
@@ -481,5 +481,23 @@ TEST(MRealTest, ExactlyAndOneOfConstraintsWithVariablesShouldWork) {
   }
 }
 
+TEST(MRealTest, FindInvalidValueReturnsTheFirstInvalidIndex) {
+  moriarty_internal::ValueSet values;
+  moriarty_internal::VariableSet variables;
+  ConstraintContext ctx("_", variables, values);
+
+  EXPECT_EQ(MReal(Between(0, 1)).FindInvalidValue(ctx, {}), std::nullopt);
+  EXPECT_EQ(MReal(Between(0, 1)).FindInvalidValue(ctx, {{0.0, 1.0, 0.5}}),
+            std::nullopt);
+  EXPECT_THAT(MReal(Between(0, 1)).FindInvalidValue(ctx, {{0.5, -0.5, 2.0}}),
+              Optional(1));
+  EXPECT_THAT(MReal(Between(0, 1))
+                  .FindInvalidValue(
+                      ctx, {{0.5, std::numeric_limits<double>::quiet_NaN()}}),
+              Optional(1));
+  EXPECT_THAT(MReal(OneOf({1, 2})).FindInvalidValue(ctx, {{1.0, 2.0, 3.0}}),
+              Optional(2));
+}
+
 }  // namespace
 }  // namespace moriarty
@@ -171,9 +171,8 @@ std::string MString::GenerateImpl(
   int length = length_local.Generate(ctx.ForSubVariable("length"));
 
   std::vector<char> alphabet(core_constraints_.Alphabet().GetOptions());
-  std::vector<char> ret = ctx.RandomElementsWithReplacement(alphabet, length);
-
-  return std::string(ret.begin(), ret.end());
+  return ctx.RandomString(std::string_view(alphabet.data(), alphabet.size()),
+                          length);
 }
 
 std::string MString::GenerateSimplePattern(
@@ -190,7 +189,9 @@ std::string MString::GenerateSimplePattern(
   auto lookup = [&](std::string_view name) -> int64_t {
     return ctx.GenerateVariable<MInteger>(name);
   };
-  auto rand = [&](int min, int max) { return ctx.RandomInteger(min, max); };
+  auto rand = [&](int64_t min, int64_t max) {
+    return ctx.RandomInteger(min, max);
+  };
   try {
     // Use the last pattern, since it's probably the most specific. This choice
     // is arbitrary since all patterns must be satisfied.
@@ -105,6 +105,15 @@ TEST(MStringTest, GenerateShouldSuccessfullyComplete) {
               GeneratedValuesAre(SizeIs(4)));
 }
 
+TEST(MStringTest, GenerateLongStringsShouldSucceed) {
+  EXPECT_THAT(MString(Length(100000), Alphabet("abc")),
+              GeneratedValuesAre(AllOf(SizeIs(100000), MatchesRegex("[abc]*"),
+                                       Contains('a'), Contains('c'))));
+  EXPECT_THAT(MString(Length(100000), Alphabet("abcd")),
+              GeneratedValuesAre(AllOf(SizeIs(100000), MatchesRegex("[abcd]*"),
+                                       Contains('a'), Contains('d'))));
+}
+
 TEST(MStringTest, RepeatedLengthCallsShouldBeIntersectedTogether) {
   auto gen_given_length1 = [](int lo, int hi) {
     return MString(Length(Between(lo, hi)), Alphabet("abcdef"));